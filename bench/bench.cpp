@@ -0,0 +1,264 @@
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "harness.hpp"
+
+using namespace bench;
+using namespace commandIO;
+
+using std::index_sequence;
+using std::make_index_sequence;
+using std::to_string;
+
+int increase(int a) {
+	return a + 1;
+}
+
+float multiply(float a, int b) {
+	return a * b;
+}
+
+int add(vector<int> v) {
+	int sum = 0;
+	for (int element: v) {
+		sum += element;
+	}
+	return sum;
+}
+
+template <size_t N>
+int identity(int a) {
+	return a + int(N);
+}
+
+template <size_t>
+using Flag = bool;
+
+vector<string> names(char const *prefix, size_t n) {
+	vector<string> result;
+	for (size_t i{ 0 }; i < n; i++) {
+		result.push_back(prefix + to_string(i));
+	}
+	return result;
+}
+
+vector<string> const commandNames{ names("command", 256) };
+vector<string> const flagNames{ names("-flag", 64) };
+
+size_t const batch{ 1000 };
+
+// Tokenize a script held in memory with every available kernel.
+void tokenize(Runner &runner) {
+	char const *lines[]{
+		"inc 1\n", "mul -a 2 3\n", "add 1 2 3 4 5 6 7 8\n",
+		"help \"quoted value\"\n", "   show\t\tall  \n" };
+	string script;
+	size_t count{ 0 };
+
+	while (script.size() < (1 << 20)) {
+		script += lines[count++ % 5];
+	}
+
+	vector<char> data(script.size());
+	char const *kernels[]{ "scalar", "sse2", "avx2" };
+
+	for (int kernel{ SCALAR }; kernel <= bestKernel(); kernel++) {
+		runner.run(
+				"tokenize", kernels[kernel], count,
+				[&]() { memcpy(data.data(), script.data(), script.size()); },
+				[&]() {
+					InputBuffer input(0, Kernel(kernel));
+
+					input.assign(data.data(), data.size());
+					while (input.next() or (input.receive() and input.next())) {
+						while (not input.eol()) {
+							keep(input.read());
+						}
+					}
+				},
+				script.size() / count);
+	}
+}
+
+// Look up and run one of `N` commands.
+template <size_t... Is>
+void select(Runner &runner, index_sequence<Is...>) {
+	size_t const n{ sizeof...(Is) };
+	auto defs{ pack(func(
+			identity<Is>, commandNames[Is].c_str(), "Identity.",
+			param("a", "value"))...) };
+	Table<n> table{ defs };
+	vector<string_view> args{ "42" };
+	BenchIO io;
+
+	runner.run("select", to_string(n), batch, [&]() {
+		io.output.clear();
+		for (size_t i{ 0 }; i < batch; i++) {
+			io.reset(&args);
+			keep(select(io, commandNames[i % n], defs, table));
+		}
+	});
+}
+
+// Convert a string to one type.
+template <class T>
+void convert(Runner &runner, char const *type, string_view token) {
+	runner.run("convert", type, batch, [&]() {
+		for (size_t i{ 0 }; i < batch; i++) {
+			T value{};
+			keep(convert(&value, token));
+			keep(value);
+		}
+	});
+}
+
+// Update the last of `N` flags.
+template <size_t... Is>
+void optional(Runner &runner, index_sequence<Is...>) {
+	size_t const n{ sizeof...(Is) };
+	auto defs{ pack(param(flagNames[Is].c_str(), false, "Flag.")...) };
+	Tuple<Flag<Is>...> argv{};
+	string_view last{ flagNames[n - 1] };
+	vector<string_view> none;
+	BenchIO io;
+
+	io.reset(&none);
+	runner.run("updateOptional", to_string(n), batch, [&]() {
+		for (size_t i{ 0 }; i < batch; i++) {
+			keep(updateOptional(io, argv, defs, last));
+		}
+	});
+}
+
+// Render the help of a command and a list of commands.
+template <size_t... Is>
+void help(Runner &runner, index_sequence<Is...>) {
+	auto defs{ pack(func(
+			identity<Is>, commandNames[Is].c_str(), "Identity.",
+			param("a", "value"))...) };
+	auto params{ pack(
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")) };
+	BenchIO io;
+
+	runner.run("help", "mul", 100, [&]() {
+		io.output.clear();
+		for (size_t i{ 0 }; i < 100; i++) {
+			help(io, multiply, "mul", "Multiply a floating point number.", params);
+		}
+	});
+	runner.run("describe", to_string(sizeof...(Is)), 100, [&]() {
+		io.output.clear();
+		for (size_t i{ 0 }; i < 100; i++) {
+			describe(io, defs);
+		}
+	});
+}
+
+// Format one value.
+template <class T>
+void print(Runner &runner, char const *type, T const &value) {
+	BenchIO io;
+
+	runner.run("print", type, batch, [&]() {
+		io.output.clear();
+		for (size_t i{ 0 }; i < batch; i++) {
+			print(io, value, "\n");
+		}
+	});
+}
+
+// Run a script of commands through the full interface.
+void endToEnd(Runner &runner) {
+	static constexpr Interface commands(
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")),
+		func(multiply, "mul", "Multiply a floating point number.",
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")),
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+	vector<vector<string>> lines;
+	std::unique_ptr<MemoryIO> io;
+
+	for (size_t i{ 0 }; i < 100000; i++) {
+		switch (i % 3) {
+			case 0:
+				lines.push_back({ "inc", to_string(i) });
+				break;
+			case 1:
+				lines.push_back({ "mul", "-a", "2.5", to_string(i) });
+				break;
+			default:
+				lines.push_back({ "add", "1", "2", "3", to_string(i) });
+		}
+	}
+
+	runner.run(
+			"endToEnd", "memory", lines.size(),
+			[&]() { io = std::make_unique<MemoryIO>(lines); },
+			[&]() { commands.run(*io); });
+}
+
+int main(int argc, char **argv) {
+	char const *format{ "csv" };
+	string filter;
+	double minTime{ 0.05 };
+	size_t samples{ 5 };
+
+	for (int i{ 1 }; i + 1 < argc; i += 2) {
+		if (not strcmp(argv[i], "-f")) {
+			format = argv[i + 1];
+		} else if (not strcmp(argv[i], "-b")) {
+			filter = argv[i + 1];
+		} else if (not strcmp(argv[i], "-t")) {
+			minTime = atof(argv[i + 1]);
+		} else if (not strcmp(argv[i], "-n")) {
+			samples = std::max(1, atoi(argv[i + 1]));
+		} else {
+			fprintf(
+					stderr, "usage: %s [-f csv|json] [-b name] [-t seconds] [-n samples]\n",
+					argv[0]);
+			return 1;
+		}
+	}
+
+	Runner runner(filter, minTime, samples);
+
+	tokenize(runner);
+
+	select(runner, make_index_sequence<1>{});
+	select(runner, make_index_sequence<16>{});
+	select(runner, make_index_sequence<128>{});
+
+	convert<int>(runner, "int", "-12345");
+	convert<unsigned long>(runner, "unsigned long", "1234567890");
+	convert<float>(runner, "float", "3.14159");
+	convert<double>(runner, "double", "-2.718281828e-3");
+	convert<string>(runner, "string", "hello");
+	convert<vector<int>>(runner, "vector<int>", "42");
+
+	optional(runner, make_index_sequence<1>{});
+	optional(runner, make_index_sequence<8>{});
+	optional(runner, make_index_sequence<32>{});
+
+	help(runner, make_index_sequence<16>{});
+
+	print(runner, "int", -12345);
+	print(runner, "double", 3.14159);
+	print(runner, "string", string{ "hello" });
+	print(runner, "vector<int>", vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+	endToEnd(runner);
+
+	if (not strcmp(format, "json")) {
+		runner.json(stdout);
+	} else {
+		runner.csv(stdout);
+	}
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <commandIO.hpp>
+
+namespace bench {
+
+	using std::size_t;
+	using std::string;
+	using std::string_view;
+	using std::vector;
+
+	/*!
+	 * Keep a value alive so that the computation of it is not optimised away.
+	 *
+	 * \param value Value.
+	 */
+	template <class T>
+	void keep(T const &value) {
+		asm volatile("" : : "g"(&value) : "memory");
+	}
+
+	/*!
+	 * Input / output object that reads from a list of tokens and writes to a
+	 * string.
+	 */
+	struct BenchIO {
+		void reset(vector<string_view> const *tokens) {
+			this->tokens = tokens;
+			token = 0;
+		}
+
+		bool eol() const {
+			return token == tokens->size();
+		}
+
+		void flush() {
+			token = tokens->size();
+		}
+
+		string_view read() {
+			return (*tokens)[token++];
+		}
+
+		void write(char const *data, size_t size) {
+			output.append(data, size);
+		}
+
+		void write(string const &data) {
+			output.append(data);
+		}
+
+		static inline vector<string_view> const none{};
+
+		vector<string_view> const *tokens{ &none };
+		size_t token{ 0 };
+		bool interactive{ false };
+		string output;
+		commandIO::Format format;
+		commandIO::Session session;
+		size_t tasks{ 0 };
+	};
+
+	/*! Measurement of one benchmark. */
+	struct Result {
+		string name;
+		string param;
+		size_t ops; ///< Operations per sample.
+		double median; ///< Nanoseconds per operation.
+		double best; ///< Nanoseconds per operation.
+		size_t bytes; ///< Bytes per operation, 0 if not applicable.
+	};
+
+	/*!
+	 * Benchmark runner.
+	 *
+	 * Every benchmark is sampled a fixed number of times after a warm up,
+	 * each sample runs the body at least `minTime` seconds.
+	 */
+	class Runner {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param filter Only run benchmarks whose name contains `filter`.
+		 * \param minTime Minimal duration of a sample in seconds.
+		 * \param samples Number of samples.
+		 */
+		Runner(string filter, double minTime, size_t samples)
+				: filter_{ filter }, minTime_{ minTime }, samples_{ samples } {}
+
+		/*!
+		 * Run one benchmark.
+		 *
+		 * \param name Benchmark name.
+		 * \param param Benchmark parameter.
+		 * \param ops Operations done by one call of `body`.
+		 * \param setup Called before every call of `body`, not measured.
+		 * \param body Benchmark body.
+		 * \param bytes Bytes processed by one operation.
+		 */
+		template <class S, class B>
+		void run(
+				string const &name, string const &param, size_t ops, S setup,
+				B body, size_t bytes = 0) {
+			using Clock = std::chrono::steady_clock;
+
+			if (name.find(filter_) == string::npos) {
+				return;
+			}
+
+			vector<double> times;
+			size_t calls{ 1 };
+
+			setup();
+			body();
+			for (size_t i{ 0 }; i <= samples_; i++) {
+				Clock::duration total{ 0 };
+
+				for (size_t j{ 0 }; j < calls; j++) {
+					setup();
+					Clock::time_point start{ Clock::now() };
+					body();
+					total += Clock::now() - start;
+				}
+
+				double seconds{ std::chrono::duration<double>(total).count() };
+				if (not i) {
+					// Calibration run.
+					calls = std::max(size_t(1), size_t(minTime_ / (seconds / calls)));
+					continue;
+				}
+				times.push_back(seconds * 1e9 / double(calls * ops));
+			}
+
+			std::sort(times.begin(), times.end());
+			results_.push_back(
+					{ name, param, ops, times[times.size() / 2], times[0], bytes });
+			fprintf(
+					stderr, "%-24s %-12s %12.1f ns/op\n", name.c_str(), param.c_str(),
+					times[times.size() / 2]);
+		}
+
+		template <class B>
+		void run(
+				string const &name, string const &param, size_t ops, B body,
+				size_t bytes = 0) {
+			run(name, param, ops, []() {}, body, bytes);
+		}
+
+		/*!
+		 * Write all results as CSV.
+		 *
+		 * \param out Output stream.
+		 */
+		void csv(FILE *out) const {
+			fprintf(out, "name,param,ns_per_op,best_ns_per_op,ops_per_s,bytes_per_s\n");
+			for (Result const &result: results_) {
+				fprintf(
+						out, "%s,%s,%.3f,%.3f,%.1f,%.1f\n", result.name.c_str(),
+						result.param.c_str(), result.median, result.best,
+						1e9 / result.median, result.bytes * 1e9 / result.median);
+			}
+		}
+
+		/*!
+		 * Write all results as JSON.
+		 *
+		 * \param out Output stream.
+		 */
+		void json(FILE *out) const {
+			fprintf(out, "[\n");
+			for (size_t i{ 0 }; i < results_.size(); i++) {
+				Result const &result{ results_[i] };
+				fprintf(
+						out,
+						"  {\"name\": \"%s\", \"param\": \"%s\", \"ns_per_op\": %.3f, "
+						"\"best_ns_per_op\": %.3f, \"ops_per_s\": %.1f, "
+						"\"bytes_per_s\": %.1f}%s\n",
+						result.name.c_str(), result.param.c_str(), result.median,
+						result.best, 1e9 / result.median,
+						result.bytes * 1e9 / result.median,
+						i + 1 < results_.size() ? "," : "");
+			}
+			fprintf(out, "]\n");
+		}
+
+	private:
+		string filter_;
+		double minTime_;
+		size_t samples_;
+		vector<Result> results_;
+	};
+}
@@ -32,8 +32,7 @@ string flood(string name, int times) {
 int main(int argc, char** argv) {
 	CliIO io(argc, argv);
 
-	interface(
-		io,
+	Interface commands(
 		func(hi, "hi", "simple greeting",
 			param("-s", false, "shout")),
 		func(greet, "greet", "personal greeting",
@@ -42,5 +41,7 @@ int main(int argc, char** argv) {
 			param("name", "name"),
 			param("-n", 1, "multiplier")));
 
+	commands.run(io);
+
 	return 0;
 }
@@ -0,0 +1,67 @@
+#include <cinttypes>
+#include <cstdlib>
+#include <thread>
+
+#include <commandIO.hpp>
+
+using namespace commandIO;
+
+
+void show(Metrics const &metrics) {
+	printf(
+		"pid %" PRIu64 ", update %" PRIu64 ": %" PRIu64 " commands, %" PRIu64
+		" errors, %" PRIu64 " queued tasks on %" PRIu64 " threads\n",
+		metrics.pid, metrics.updates, metrics.dispatched, metrics.errors,
+		metrics.queued, metrics.workers);
+	printf(
+		"io: %" PRIu64 " bytes read, %" PRIu64 " bytes written in %" PRIu64
+		" writes, %" PRIu64 " tokens\n",
+		metrics.bytesRead, metrics.bytesWritten, metrics.writes, metrics.tokens);
+
+	printf("command\t\tcalls\terrors\tp50 us\tp90 us\tp99 us\tmax us\n");
+	for (size_t i = 0; i < metrics.size; i++) {
+		MetricsCommand const &command = metrics.commands[i];
+		uint64_t errors = 0;
+
+		for (uint64_t count: command.errors) {
+			errors += count;
+		}
+		printf(
+			"%s\t\t%" PRIu64 "\t%" PRIu64 "\t%.1f\t%.1f\t%.1f\t%.1f\n",
+			command.name, command.calls, errors, command.p50 / 1e3,
+			command.p90 / 1e3, command.p99 / 1e3, command.max / 1e3);
+	}
+	if (metrics.dropped) {
+		printf("%" PRIu64 " more commands\n", metrics.dropped);
+	}
+	fflush(stdout);
+}
+
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s segment [interval ms]\n", argv[0]);
+		return 1;
+	}
+
+	MetricsReader reader;
+	Metrics metrics;
+	int interval = argc > 2 ? atoi(argv[2]) : 0;
+
+	if (not reader.open(argv[1])) {
+		fprintf(stderr, "cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	// Show the metrics once, or every `interval` milliseconds.
+	do {
+		if (not reader.read(metrics)) {
+			fprintf(stderr, "no metrics in %s\n", argv[1]);
+			return 1;
+		}
+		show(metrics);
+		std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+	} while (interval > 0);
+
+	return 0;
+}
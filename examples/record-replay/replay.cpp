@@ -0,0 +1,78 @@
+#include <cstring>
+
+#include <commandIO.hpp>
+
+using namespace commandIO;
+
+int increase(int a) {
+	return a + 1;
+}
+
+float multiply(float a, int b) {
+	return a * b;
+}
+
+int add(vector<int> v) {
+	int sum = 0;
+	for (int element: v) {
+		sum += element;
+	}
+	return sum;
+}
+
+
+int main(int argc, char **argv) {
+	static constexpr Interface commands(
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")),
+		func(multiply, "mul", "Multiply a floating point number.",
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")),
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+	Recording recording;
+
+	if (argc > 2 and not strcmp(argv[1], "record")) {
+		ReplIO io;
+
+		if (not recording.open(argv[2], io.interactive)) {
+			fprintf(stderr, "cannot open %s\n", argv[2]);
+			return 1;
+		}
+
+		Recorder<ReplIO> recorder(io, recording);
+		commands.run(recorder);
+
+		return 0;
+	}
+
+	if (argc > 2 and not strcmp(argv[1], "play")) {
+		ReplayOptions options;
+
+		for (int i = 3; i + 1 < argc; i += 2) {
+			if (not strcmp(argv[i], "-x")) {
+				options.speed = atof(argv[i + 1]);
+			} else if (not strcmp(argv[i], "-c")) {
+				options.sessions = atoi(argv[i + 1]);
+			}
+		}
+
+		if (not recording.load(argv[2])) {
+			fprintf(stderr, "cannot read %s\n", argv[2]);
+			return 1;
+		}
+
+		Report report = replay(commands, recording, options);
+		report.summary(recording, stdout);
+
+		return report.mismatches.empty() ? 0 : 2;
+	}
+
+	fprintf(
+		stderr,
+		"usage: %s record file\n"
+		"       %s play file [-x speed] [-c sessions]\n",
+		argv[0], argv[0]);
+
+	return 1;
+}
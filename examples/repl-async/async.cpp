@@ -0,0 +1,53 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <commandIO.hpp>
+
+using namespace commandIO;
+
+Task<string> later(int ms, string text) {
+	co_await sleep(std::chrono::milliseconds(ms));
+	co_return text;
+}
+
+Task<size_t> count(string path) {
+	int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+	size_t total = 0;
+	char buffer[4096];
+	ssize_t size;
+
+	while (fd != -1) {
+		co_await readable(fd);
+		size = read(fd, buffer, sizeof(buffer));
+		if (size > 0) {
+			total += size;
+		} else if (not size or errno != EAGAIN) {
+			close(fd);
+			break;
+		}
+	}
+
+	co_return total;
+}
+
+int increase(int a) {
+	return a + 1;
+}
+
+
+int main(void) {
+	ReplIO io;
+
+	static constexpr Interface commands(
+		func(later, "later", "Echo a text after a delay.",
+			param("ms", "delay in milliseconds"),
+			param("text", "text")),
+		func(count, "count", "Count the bytes of a file or a pipe.",
+			param("path", "file name")),
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")));
+
+	commands.run(io);
+
+	return 0;
+}
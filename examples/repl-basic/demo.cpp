@@ -38,8 +38,7 @@ int add(vector<int> v) {
 int main(void) {
 	ReplIO io;
 
-	while (interface(
-		io,
+	static constexpr Interface commands(
 		func(greet, "greet", "Say hi to someone.",
 			param("name", "someone's name"),
 			param("-t", 1, "greet multiple times"),
@@ -50,7 +49,9 @@ int main(void) {
 			param("-a", 1.1F, "value to be multiplied"),
 			param("b", "multiplier")),
 		func(add, "add", "Add a list of numbers.",
-			param("v", "vector of numbers"))));
+			param("v", "vector of numbers")));
+
+	commands.run(io);
 
 	return 0;
 }
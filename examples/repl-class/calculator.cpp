@@ -12,7 +12,7 @@ class Calculator {
 		void subtract(int amount) {
 			_total -= amount;
 		}
-		int show(void) {
+		int show(void) const {
 			return _total;
 		}
 	private:
@@ -24,13 +24,14 @@ int main(void) {
 	ReplIO io;
 	Calculator calc;
 
-	while (interface(
-		io,
+	Interface commands(
 		func(pack(&calc, &Calculator::add), "add", "Increase the total.",
 			param("amount", "increase by this amount")),
 		func(pack(&calc, &Calculator::subtract), "sub", "Decrease the total.",
 			param("amount", "decrease by this amount")),
-		func(pack(&calc, &Calculator::show), "show", "Show total.")));
+		func(pack(&calc, &Calculator::show), "show", "Show total."));
+
+	commands.run(io);
 
 	return 0;
 }
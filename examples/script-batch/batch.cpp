@@ -0,0 +1,62 @@
+#include <cstring>
+
+#include <commandIO.hpp>
+
+using namespace commandIO;
+
+int increase(int a) {
+	return a + 1;
+}
+
+float multiply(float a, int b) {
+	return a * b;
+}
+
+int add(vector<int> v) {
+	int sum = 0;
+	for (int element: v) {
+		sum += element;
+	}
+	return sum;
+}
+
+
+int main(int argc, char **argv) {
+	bool stop = false;
+	bool parallel = false;
+
+	for (int i = 1; i < argc - 1; i++) {
+		stop = stop or not strcmp(argv[i], "-s");
+		parallel = parallel or not strcmp(argv[i], "-p");
+	}
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s [-s] [-p] script\n", argv[0]);
+		return 1;
+	}
+
+	ScriptIO io(argv[argc - 1], stop);
+
+	if (not io.good()) {
+		fprintf(stderr, "cannot open %s\n", argv[argc - 1]);
+		return 1;
+	}
+
+	static constexpr Interface commands(
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")),
+		func(multiply, "mul", "Multiply a floating point number.",
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")),
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+
+	if (parallel) {
+		commands.batch(io);
+	} else {
+		commands.run(io);
+	}
+	io.summary();
+
+	return io.errors ? 2 : 0;
+}
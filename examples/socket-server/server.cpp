@@ -0,0 +1,87 @@
+#include <cstdlib>
+
+#include <commandIO.hpp>
+
+using namespace commandIO;
+
+int increase(int a) {
+	return a + 1;
+}
+
+float multiply(float a, int b) {
+	return a * b;
+}
+
+int add(vector<int> v) {
+	int sum = 0;
+	for (int element: v) {
+		sum += element;
+	}
+	return sum;
+}
+
+
+class Calculator {
+	public:
+		Calculator(void) {}
+		void add(int amount) {
+			_total += amount;
+		}
+		int show(void) const {
+			return _total;
+		}
+	private:
+		int _total = 0;
+};
+
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s socket|port [metrics segment]\n", argv[0]);
+		return 1;
+	}
+
+	int port = atoi(argv[1]);
+	SocketServer server = port
+		? SocketServer((unsigned short)port)
+		: SocketServer(argv[1]);
+
+	if (not server.good()) {
+		fprintf(stderr, "cannot listen on %s\n", argv[1]);
+		return 1;
+	}
+
+	static Calculator total;
+	static shared_mutex totalMutex;
+
+	// Every client has its own calculator, `total` is shared by all of them.
+	static constexpr Interface commands(
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")),
+		func(multiply, "mul", "Multiply a floating point number.",
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")),
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")),
+		func(pack(factory<Calculator>(), &Calculator::add), "calc",
+			"Increase the total of this client.",
+			param("amount", "increase by this amount")),
+		func(pack(factory<Calculator>(), &Calculator::show), "show",
+			"Show the total of this client."),
+		func(pack(shared(&total, totalMutex), &Calculator::add), "count",
+			"Increase the total of all clients.",
+			param("amount", "increase by this amount")),
+		func(pack(shared(&total, totalMutex), &Calculator::show), "total",
+			"Show the total of all clients."));
+
+	// Monitoring reads the metrics from shared memory, not from a client.
+	MetricsPublisher metrics;
+	if (argc > 2 and not metrics.open(argv[2])) {
+		fprintf(stderr, "cannot publish metrics to %s\n", argv[2]);
+		return 1;
+	}
+
+	server.run(commands);
+
+	return 0;
+}
@@ -6,6 +6,8 @@
 
 namespace commandIO {
 
+	using std::string_view;
+
 	/// \defgroup args
 
 	template <class... Args>
@@ -65,7 +67,7 @@ namespace commandIO {
 
 	/*! Update a required argument.
 	 *
-	 * \fn updateRequired(A&, D&, int, string&)
+	 * \fn updateRequired(A&, D&, int, string_view)
 	 * \ingroup args
 	 *
 	 * \param[out] argv Arguments.
@@ -77,7 +79,7 @@ namespace commandIO {
 	 * \return success on success, an error code otherwise.
 	 */
 	inline Error updateRequired_(
-			Empty, EmptyC, int const, int const, string const &) {
+			Empty, EmptyC, int const, int const, string_view) {
 		return Error::EXCESS_PARAM;
 	}
 
@@ -85,12 +87,9 @@ namespace commandIO {
 	template <class A, class... Args>
 	Error updateRequired_(
 			A &argv, Def<Args...> defs,
-			int const num, int const count, string const &value) {
+			int const num, int const count, string_view value) {
 		if (num == count) {
-			if (not convert(&argv.head, value)) {
-				return Error::INVALID_PARAM_TYPE;
-			}
-			return Error::SUCCESS;
+			return convert(&argv.head, value);
 		}
 
 		return updateRequired_(argv.tail, defs.tail, num, count + 1, value);
@@ -99,31 +98,28 @@ namespace commandIO {
 	template <class T, class... Args>
 	Error updateRequired_(
 			Tuple<vector<T>> &argv, Def<Args...>,
-			int const, int const, string const &value) {
-		if (not convert(&argv.head, value)) {
-			return Error::INVALID_PARAM_TYPE;
-		}
-		return Error::SUCCESS;
+			int const, int const, string_view value) {
+		return convert(&argv.head, value);
 	}
 
 	// Skip optional parameters.
 	template <class A, class D>
 	Error updateRequired_(
 			A &argv, D const &defs, int const num, int const count,
-			string const &value) {
+			string_view value) {
 		return updateRequired_(argv.tail, defs.tail, num, count, value);
 	}
 
 	// Entry point.
 	template <class A, class D>
 	Error updateRequired(
-			A &argv, D const &defs, int const num, string const &value) {
+			A &argv, D const &defs, int const num, string_view value) {
 		return updateRequired_(argv, defs, num, 0, value);
 	}
 
 	/*! Update an optional parameter value.
 	 *
-	 * \fn updateOptional(Tuple<H, Tail...>&, D&, string&)
+	 * \fn updateOptional(Tuple<H, Tail...>&, D&, string_view)
 	 * \ingroup args
 	 *
 	 * \param[in, out] io Input / output object.
@@ -134,14 +130,15 @@ namespace commandIO {
 	 * \return success on success, an error code otherwise.
 	 */
 	template <class I>
-	Error updateOptional(I &, Empty, EmptyC, string const &) {
+	Error updateOptional(I &, Empty, EmptyC, string_view) {
 		return Error::UNKNOWN_PARAM;
 	}
 
 	// Update flag parameter.
 	template <class I, class... Tail, class D>
 	Error updateOptional(
-			I &io, Tuple<bool, Tail...> &argv, D const &defs, string const &name) {
+			I &io, Tuple<bool, Tail...> &argv, D const &defs,
+			string_view name) {
 		if (defs.head.head == name) {
 			argv.head = not argv.head;
 			return Error::SUCCESS;
@@ -153,15 +150,13 @@ namespace commandIO {
 	// Update optional parameter.
 	template <class I, class H, class... Tail, class D>
 	Error updateOptional(
-			I &io, Tuple<H, Tail...> &argv, D const &defs, string const &name) {
+			I &io, Tuple<H, Tail...> &argv, D const &defs,
+			string_view name) {
 		if (defs.head.head == name) {
 			if (io.eol()) {
 				return Error::MISSING_VALUE;
 			}
-			if (not convert(&argv.head, io.read())) {
-				return Error::INVALID_PARAM_TYPE;
-			}
-			return Error::SUCCESS;
+			return convert(&argv.head, io.read());
 		}
 		return updateOptional(io, argv.tail, defs.tail, name);
 	}
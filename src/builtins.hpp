@@ -0,0 +1,28 @@
+#pragma once
+
+namespace commandIO {
+
+	/*!
+	 * Built in commands besides `help`. An input / output object lists the
+	 * ones it supports in a `builtins` member, it supports all of them if it
+	 * has none.
+	 */
+	enum Builtin : unsigned {
+		STATS = 1, ///< `stats`.
+		MAP = 2, ///< `map`.
+		PROFILE = 4, ///< `profile`.
+		JOBS = 8, ///< `bg`, `&`, `jobs`, `wait` and `result`.
+		BUILTINS = 15 ///< All of them.
+	};
+
+	// Built in commands of an input / output object.
+	template <class I>
+	auto builtins_(I const &io, int) -> decltype(unsigned(io.builtins)) {
+		return io.builtins;
+	}
+
+	template <class I>
+	unsigned builtins_(I const &, long) {
+		return Builtin::BUILTINS;
+	}
+}
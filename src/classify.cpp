@@ -0,0 +1,76 @@
+#include "classify.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COMMANDIO_X86
+#endif
+
+namespace commandIO {
+
+#ifdef COMMANDIO_X86
+	static Masks classifySse2_(char const *data) {
+		__m128i const space{ _mm_set1_epi8(' ') };
+		__m128i const tab{ _mm_set1_epi8('\t') };
+		__m128i const newline{ _mm_set1_epi8('\n') };
+		__m128i const quote{ _mm_set1_epi8('"') };
+		__m128i const backslash{ _mm_set1_epi8('\\') };
+		Masks masks{ 0, 0, 0 };
+
+		for (size_t i{ 0 }; i < blockSize; i += 16) {
+			__m128i block{
+				_mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i)) };
+
+			masks.separator |= uint32_t(_mm_movemask_epi8(_mm_or_si128(
+					_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)))) << i;
+			masks.newline |=
+					uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline))) << i;
+			masks.special |= uint32_t(_mm_movemask_epi8(_mm_or_si128(
+					_mm_cmpeq_epi8(block, quote),
+					_mm_cmpeq_epi8(block, backslash)))) << i;
+		}
+
+		return masks;
+	}
+
+	__attribute__((target("avx2")))
+	static Masks classifyAvx2_(char const *data) {
+		__m256i const block{
+			_mm256_loadu_si256(reinterpret_cast<__m256i const *>(data)) };
+
+		return {
+			uint32_t(_mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')),
+					_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))))),
+			uint32_t(_mm256_movemask_epi8(
+					_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')))),
+			uint32_t(_mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')),
+					_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\\'))))) };
+	}
+#endif
+
+	Kernel bestKernel() {
+#ifdef COMMANDIO_X86
+		if (__builtin_cpu_supports("avx2")) {
+			return Kernel::AVX2;
+		}
+		if (__builtin_cpu_supports("sse2")) {
+			return Kernel::SSE2;
+		}
+#endif
+		return Kernel::SCALAR;
+	}
+
+	Classifier classifier(Kernel kernel) {
+		switch (kernel) {
+#ifdef COMMANDIO_X86
+			case Kernel::AVX2:
+				return classifyAvx2_;
+			case Kernel::SSE2:
+				return classifySse2_;
+#endif
+			default:
+				return nullptr;
+		}
+	}
+}
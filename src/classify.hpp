@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace commandIO {
+
+	using std::size_t;
+	using std::uint32_t;
+
+	/// \defgroup classify
+
+	size_t const blockSize{ 32 };
+
+	/*!
+	 * Character classes of one block of input, bit `i` corresponds to byte `i`.
+	 *
+	 * \ingroup classify
+	 */
+	struct Masks {
+		uint32_t separator; ///< Space or tab.
+		uint32_t newline; ///< Line ending.
+		uint32_t special; ///< Quote or backslash.
+	};
+
+	/*!
+	 * Tokenizer kernels.
+	 *
+	 * \ingroup classify
+	 */
+	enum Kernel {
+		SCALAR, ///< Byte at a time state machine.
+		SSE2,
+		AVX2
+	};
+
+	using Classifier = Masks (*)(char const *);
+
+	/*!
+	 * Best kernel supported by this processor.
+	 *
+	 * \ingroup classify
+	 *
+	 * \return Kernel.
+	 */
+	Kernel bestKernel();
+
+	/*!
+	 * Block classifier for a kernel.
+	 *
+	 * \ingroup classify
+	 *
+	 * \param kernel Kernel.
+	 *
+	 * \return Function that classifies `blockSize` bytes at a time, `nullptr`
+	 *   for the scalar kernel.
+	 */
+	Classifier classifier(Kernel);
+}
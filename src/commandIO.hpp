@@ -1,10 +1,15 @@
 #pragma once
 
 #include "interface.hpp"
+#include "metrics.hpp"
+#include "record.hpp"
 
 // I/O plugins.
 #include "plugins/cli/io.hpp"
+#include "plugins/memory/io.hpp"
 #include "plugins/repl/io.hpp"
+#include "plugins/script/io.hpp"
+#include "plugins/socket/io.hpp"
 #include "tuple.hpp"
 
 namespace commandIO {
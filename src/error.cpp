@@ -6,6 +6,11 @@ namespace commandIO {
 		"Excess parameter: ",
 		"Missing value for parameter ",
 		"Wrong type for parameter ",
-		"Unknown parameter: "
+		"Unknown parameter: ",
+		"Line too long, maximum length: ",
+		"Value out of range for parameter ",
+		"Trailing characters in parameter ",
+		"Required parameter missing.",
+		"Unknown command: "
 	};
 }
@@ -6,7 +6,12 @@ namespace commandIO {
 		EXCESS_PARAM,
 		MISSING_VALUE,
 		INVALID_PARAM_TYPE,
-		UNKNOWN_PARAM
+		UNKNOWN_PARAM,
+		LINE_TOO_LONG,
+		OUT_OF_RANGE,
+		TRAILING_CHARACTERS,
+		MISSING_PARAM,
+		UNKNOWN_COMMAND
 	};
 
 	extern const char *errorMessages[];
@@ -1,23 +1,47 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "error.hpp"
+#include "hooks.hpp"
 #include "tuple.hpp"
+#include "table.hpp"
 #include "args.hpp"
+#include "lock.hpp"
+#include "print.hpp"
+#include "profile.hpp"
+#include "session.hpp"
+#include "stats.hpp"
+#include "task.hpp"
 
 namespace commandIO {
 
 	/// \defgroup eval
 
+	using std::array;
+	using std::decay_t;
+	using std::index_sequence;
+	using std::index_sequence_for;
 	using std::string;
+	using std::string_view;
 	using namespace commandIO;
 
-	template <class C, class P, class... Args>
-	using VoidM = Tuple<C *, void (P::*)(Args...)> const &;
+	// `O` is a pointer, a `Shared` instance or a `Factory`.
+	template <class O, class P, class... Args>
+	using VoidM = Tuple<O, void (P::*)(Args...)> const &;
 
-	template <class C, class R, class P, class... Args>
-	using RetM = Tuple<C *, R (P::*)(Args...)> const &;
+	template <class O, class R, class P, class... Args>
+	using RetM = Tuple<O, R (P::*)(Args...)> const &;
+
+	template <class O, class P, class... Args>
+	using VoidC = Tuple<O, void (P::*)(Args...) const> const &;
+
+	template <class O, class R, class P, class... Args>
+	using RetC = Tuple<O, R (P::*)(Args...) const> const &;
 
 	template <class... Args>
 	using VoidF = void (*const)(Args...);
@@ -29,56 +53,173 @@ namespace commandIO {
 	 * Recursion terminators.
 	 *
 	 * All parameters have been collected. All values are now present in the
-	 * `args` parameter pack.
+	 * `args` parameter pack. Arguments are stored by value and cast to the
+	 * declared parameter types, so they are moved into value and rvalue
+	 * reference parameters and bound directly to lvalue reference parameters.
+	 *
+	 * Instances are locked while a class member function runs, const member
+	 * functions take a shared lock. `done` is called with the return value
+	 * before the lock is released.
 	 */
 
 	// Void class member function.
-	template <class I, class C, class P, class... FArgs, class... Args>
-	void call_(I &, VoidM<C, P, FArgs...> m, Empty, Args &...args) {
-		(*m.head.*m.tail.head)(args...);
+	template <class I, class O, class P, class... FArgs, class K, class... Args>
+	void call_(I &io, VoidM<O, P, FArgs...> m, K &done, Empty, Args &...args) {
+		Lock lock{ acquire(io, m.head, false) };
+		(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...);
+		done(Void{});
+	}
+
+	// Void const class member function.
+	template <class I, class O, class P, class... FArgs, class K, class... Args>
+	void call_(I &io, VoidC<O, P, FArgs...> m, K &done, Empty, Args &...args) {
+		Lock lock{ acquire(io, m.head, true) };
+		(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...);
+		done(Void{});
 	}
 
 	// Void function.
-	template <class I, class... FArgs, class... Args>
-	void call_(I &, VoidF<FArgs...> f, Empty, Args &...args) {
-		f(args...);
+	template <class I, class... FArgs, class K, class... Args>
+	void call_(I &, VoidF<FArgs...> f, K &done, Empty, Args &...args) {
+		f(static_cast<FArgs &&>(args)...);
+		done(Void{});
 	}
 
 	// Class member function that returns a value.
-	template <class I, class C, class R, class P, class... FArgs, class... Args>
-	void call_(I &io, RetM<C, R, P, FArgs...> m, Empty, Args &...args) {
-		print(io, (*m.head.*m.tail.head)(args...), "\n");
+	template <
+			class I, class O, class R, class P, class... FArgs, class K,
+			class... Args>
+	void call_(I &io, RetM<O, R, P, FArgs...> m, K &done, Empty, Args &...args) {
+		Lock lock{ acquire(io, m.head, false) };
+		decltype(auto) result =
+				(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...);
+		print(io, result, "\n");
+		done(result);
+	}
+
+	// Const class member function that returns a value.
+	template <
+			class I, class O, class R, class P, class... FArgs, class K,
+			class... Args>
+	void call_(I &io, RetC<O, R, P, FArgs...> m, K &done, Empty, Args &...args) {
+		Lock lock{ acquire(io, m.head, true) };
+		decltype(auto) result =
+				(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...);
+		print(io, result, "\n");
+		done(result);
 	}
 
 	// Function that returns a value.
-	template <class I, class F, class... Args>
-	void call_(I &io, F f, Empty, Args &...args) {
-		print(io, f(args...), "\n");
+	template <class I, class R, class... FArgs, class K, class... Args>
+	void call_(I &io, RetF<R, FArgs...> f, K &done, Empty, Args &...args) {
+		decltype(auto) result = f(static_cast<FArgs &&>(args)...);
+		print(io, result, "\n");
+		done(result);
+	}
+
+#ifdef COMMANDIO_COROUTINES
+	/*
+	 * Tasks.
+	 *
+	 * A task runs after `call_` has returned, so instances are only locked
+	 * while the task is made, not while it runs. The reactor runs all tasks
+	 * of an input / output object on one thread.
+	 */
+
+	// Class member function that returns a task.
+	template <
+			class I, class O, class R, class P, class... FArgs, class K,
+			class... Args>
+	void call_(
+			I &io, RetM<O, Task<R>, P, FArgs...> m, K &done, Empty,
+			Args &...args) {
+		static_assert(
+				(not std::is_reference_v<FArgs> and ...),
+				"task parameters must be passed by value");
+		Lock lock{ acquire(io, m.head, false) };
+		spawn_(
+				io,
+				(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...));
+		done(Void{});
+	}
+
+	// Const class member function that returns a task.
+	template <
+			class I, class O, class R, class P, class... FArgs, class K,
+			class... Args>
+	void call_(
+			I &io, RetC<O, Task<R>, P, FArgs...> m, K &done, Empty,
+			Args &...args) {
+		static_assert(
+				(not std::is_reference_v<FArgs> and ...),
+				"task parameters must be passed by value");
+		Lock lock{ acquire(io, m.head, true) };
+		spawn_(
+				io,
+				(object(io, m.head).*m.tail.head)(static_cast<FArgs &&>(args)...));
+		done(Void{});
 	}
 
+	// Function that returns a task, its value is printed when it completes.
+	template <class I, class R, class... FArgs, class K, class... Args>
+	void call_(I &io, RetF<Task<R>, FArgs...> f, K &done, Empty, Args &...args) {
+		static_assert(
+				(not std::is_reference_v<FArgs> and ...),
+				"task parameters must be passed by value");
+		spawn_(io, f(static_cast<FArgs &&>(args)...));
+		done(Void{});
+	}
+#endif
+
 	/*
 	 * Parameter collection.
 	 *
 	 * The first member of the tuple `argv` is added to the parameter pack
 	 * `args`.
 	 */
-	template <class I, class F, class A, class... Args>
-	void call_(I &io, F f, A &argv, Args &...args) {
-		call_(io, f, argv.tail, args..., argv.head);
+	template <class I, class F, class K, class A, class... Args>
+	void call_(I &io, F f, K &done, A &argv, Args &...args) {
+		call_(io, f, done, argv.tail, args..., argv.head);
 	}
 
+	// Callback that ignores the result of a call.
+	struct Ignore_ {
+		template <class R>
+		void operator()(R const &) const {}
+	};
+
 	/*! Call a class member function.
 	 *
 	 * \ingroup eval
 	 *
 	 * \param io Input / output object.
-	 * \param m Tuple containing pointers to a class instance and a class member
-	 *   function.
+	 * \param m Tuple containing a class instance and a pointer to a class
+	 *   member function.
 	 * \param argv Tuple containing arguments.
+	 * \param done Called with the return value, or `Void`, after the call.
 	 */
-	template <class I, class C, class R, class P, class... FArgs, class A>
-	void call(I &io, RetM<C, R, P, FArgs...> m, A &argv) {
-		call_(io, m, argv);
+	template <
+			class I, class O, class R, class P, class... FArgs, class A,
+			class K = Ignore_>
+	void call(I &io, RetM<O, R, P, FArgs...> m, A &argv, K done = {}) {
+		call_(io, m, done, argv);
+	}
+
+	/*! Call a const class member function.
+	 *
+	 * \ingroup eval
+	 *
+	 * \param io Input / output object.
+	 * \param m Tuple containing a class instance and a pointer to a const class
+	 *   member function.
+	 * \param argv Tuple containing arguments.
+	 * \param done Called with the return value, or `Void`, after the call.
+	 */
+	template <
+			class I, class O, class R, class P, class... FArgs, class A,
+			class K = Ignore_>
+	void call(I &io, RetC<O, R, P, FArgs...> m, A &argv, K done = {}) {
+		call_(io, m, done, argv);
 	}
 
 	/*! Call a function.
@@ -88,37 +229,45 @@ namespace commandIO {
 	 * \param io Input / output object.
 	 * \param f Function pointer.
 	 * \param argv Tuple containing arguments.
+	 * \param done Called with the return value, or `Void`, after the call.
 	 */
-	template <class I, class F, class A>
-	void call(I &io, F f, A &argv) {
-		call_(io, f, argv);
+	template <class I, class F, class A, class K = Ignore_>
+	void call(I &io, F f, A &argv, K done = {}) {
+		call_(io, f, done, argv);
 	}
 
 	/*! Set defaults, collect parameters, do sanity checking and call a function.
+	 *
+	 * \tparam H Hook policy.
 	 *
 	 * \param io Input / output object.
 	 * \param f Function pointer or Tuple for class member functions.
 	 * \param argv Tuple containing arguments.
 	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
 	 *
 	 * \return `true` on success, `false` otherwise.
 	 */
-	template <class I, class F, class A, class D>
-	bool parse_(I &io, F f, A &argv, D &defs) {
+	template <class H, class I, class F, class A, class D>
+	bool parse_(I &io, F f, A &argv, D &defs, char const *name) {
 		int number{ 0 };
 
 		setDefault(argv, defs);
 
 		while (!io.eol()) {
 			Error errorCode;
-			string token{ io.read() };
+			string_view token{ io.read() };
+			uint64_t start{ Profile::start() };
 
-			if (token[0] == '-') {
+			H::onToken(token);
+
+			if (not token.empty() and token[0] == '-') {
 				if (token == "-h" || token == "--help") {
 					return false;
 				}
 
 				errorCode = updateOptional(io, argv, defs, token);
+				start = Profile::converted(start);
 
 				switch (errorCode) {
 					case Error::SUCCESS:
@@ -126,18 +275,23 @@ namespace commandIO {
 					case Error::UNKNOWN_PARAM:
 						break;
 					default:
+						H::onError(errorCode);
+						Stats::error(errorCode);
 						print(io, errorMessages[errorCode], token, "\n");
 						return false;
 				}
 			}
 
 			errorCode = updateRequired(argv, defs, number, token);
+			Profile::converted(start);
 
 			switch (errorCode) {
 				case Error::SUCCESS:
 					number++;
 					continue;
 				default:
+					H::onError(errorCode);
+					Stats::error(errorCode);
 					print(io, errorMessages[errorCode], number + 1, "\n");
 					return false;
 			}
@@ -148,11 +302,22 @@ namespace commandIO {
 		countArgs(req, opt, defs);
 
 		if (number < req) {
-			print(io, "Required parameter missing.\n");
+			H::onError(Error::MISSING_PARAM);
+			Stats::error(Error::MISSING_PARAM);
+			print(io, errorMessages[Error::MISSING_PARAM], "\n");
 			return false;
 		}
 
-		call(io, f, argv);
+		if (not H::beforeCall(name, std::as_const(argv))) {
+			return false;
+		}
+
+		uint64_t start{ Profile::start() };
+		uint64_t begin{ H::timed ? ticks() : 0 };
+		call(io, f, argv, [name, begin](auto const &result) {
+			H::afterCall(name, result, H::timed ? ticks() - begin : 0);
+		});
+		Profile::called(start);
 
 		return true;
 	}
@@ -161,60 +326,123 @@ namespace commandIO {
 	 *
 	 * \ingroup eval
 	 *
+	 * \tparam H Hook policy.
+	 *
 	 * \param io Input / output object.
-	 * \param m Tuple containing pointers to a class instance and a class member
-	 *   function.
+	 * \param m Tuple containing a class instance and a pointer to a class
+	 *   member function.
 	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
 	 *
 	 * \return `true` on success, `false` otherwise.
 	 */
-	template <class I, class C, class R, class P, class... FArgs, class D>
-	bool parse(I &io, RetM<C, R, P, FArgs...> m, D &defs) {
-		Tuple<FArgs...> argv;
-		return parse_(io, m, argv, defs);
+	template <
+			class H = NoHooks, class I, class O, class R, class P, class... FArgs,
+			class D>
+	bool parse(
+			I &io, RetM<O, R, P, FArgs...> m, D &defs, char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return parse_<H>(io, m, argv, defs, name);
+	}
+
+	/*! Parse user input and call a const class member function.
+	 *
+	 * \ingroup eval
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param io Input / output object.
+	 * \param m Tuple containing a class instance and a pointer to a const class
+	 *   member function.
+	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <
+			class H = NoHooks, class I, class O, class R, class P, class... FArgs,
+			class D>
+	bool parse(
+			I &io, RetC<O, R, P, FArgs...> m, D &defs, char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return parse_<H>(io, m, argv, defs, name);
 	}
 
 	/*! Parse user input and call a function.
 	 *
 	 * \ingroup eval
 	 *
+	 * \tparam H Hook policy.
+	 *
 	 * \param io Input / output object.
 	 * \param f Function pointer.
 	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
 	 *
 	 * \return `true` on success, `false` otherwise.
 	 */
-	template <class I, class R, class... FArgs, class D>
-	bool parse(I &io, RetF<R, FArgs...> f, D &defs) {
-		Tuple<FArgs...> argv;
-		return parse_(io, f, argv, defs);
+	template <class H = NoHooks, class I, class R, class... FArgs, class D>
+	bool parse(I &io, RetF<R, FArgs...> f, D &defs, char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return parse_<H>(io, f, argv, defs, name);
+	}
+
+	// Parse user input and call function definition `N`.
+	template <class H, class I, class D, size_t N>
+	bool parseAt_(I &io, D const &defs) {
+		auto const &def{ get<N>(defs) };
+
+		Stats::begin(def.tail.head);
+		bool success{
+			parse<H>(io, def.head, def.tail.tail.tail, def.tail.head) };
+		Stats::end(success);
+
+		return success;
+	}
+
+	// Report a command that is not defined, it is counted as `unknownCommand`.
+	template <class H, class I>
+	void unknown_(I &io, string_view name) {
+		H::onError(Error::UNKNOWN_COMMAND);
+		Stats::begin(unknownCommand);
+		Stats::error(Error::UNKNOWN_COMMAND);
+		Stats::end(false);
+		print(io, errorMessages[Error::UNKNOWN_COMMAND], name, "\n");
+		io.flush();
+	}
+
+	// Jump table of `parseAt_()` instances.
+	template <class H, class I, class D, size_t... Is>
+	bool select_(I &io, size_t index, D const &defs, index_sequence<Is...>) {
+		static constexpr array<bool (*)(I &, D const &), sizeof...(Is)> thunks{
+			parseAt_<H, I, D, Is>... };
+		return thunks[index](io, defs);
 	}
 
 	/*! Select a function for parsing.
 	 *
-	 * \fn select(string, H, Args...)
 	 * \ingroup eval
 	 *
+	 * \tparam H Hook policy.
+	 *
 	 * \param io Input / output object.
 	 * \param name Command name.
-	 * \param t Function definition under consideration.
-	 * \param args Remaining function definitions.
+	 * \param defs Function definitions.
+	 * \param table Command table of `defs`.
 	 *
 	 * \return `true` on success, `false` otherwise.
 	 */
-	template <class I>
-	bool select(I &io, string name) {
-		print(io, "Unknown command: ", name, "\n");
-		io.flush();
-		return false;
-	}
-
-	// Entry point.
-	template <class I, class H, class... Args>
-	bool select(I &io, string name, H t, Args... args) {
-		if (t.tail.head == name) {
-			return parse(io, t.head, t.tail.tail.tail);
+	template <class H = NoHooks, class I, class... Defs, size_t N>
+	bool select(
+			I &io, string_view name, Tuple<Defs...> const &defs,
+			Table<N> const &table) {
+		size_t index{ table.find(name.data(), name.size()) };
+
+		if (index == N) {
+			unknown_<H>(io, name);
+			return false;
 		}
-		return select(io, name, args...);
+
+		return select_<H>(io, index, defs, index_sequence_for<Defs...>{});
 	}
 }
@@ -1,17 +1,39 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
+#include <string_view>
+#include <utility>
+
 #include "args.hpp"
+#include "builtins.hpp"
 #include "print.hpp"
+#include "table.hpp"
 #include "types.hpp"
 
 namespace commandIO {
 
 	/// \defgroup help
 
+	using std::array;
+	using std::decay_t;
+	using std::index_sequence;
+	using std::index_sequence_for;
+	using std::string_view;
+
 	char const helpHelp[]{ "Help on a specific command.\n" };
 	char const exitHelp[]{ "Exit.\n" };
-
-	string _flagToString(bool value) {
+	char const bgHelp[]{
+		"Run a command in the background, `command &` does the same.\n" };
+	char const jobsHelp[]{ "List background jobs.\n" };
+	char const waitHelp[]{ "Wait for a background job.\n" };
+	char const resultHelp[]{ "Show the output of a background job.\n" };
+	char const statsHelp[]{ "Show command and input / output statistics.\n" };
+	char const mapHelp[]{ "Run a command once for every set of arguments.\n" };
+	char const profileHelp[]{ "Run a command many times and show its cost.\n" };
+	size_t const profileRuns{ 100 }; ///< Default number of runs of `profile`.
+
+	inline char const *_flagToString(bool value) {
 		if (value) {
 			return "enabled";
 		}
@@ -30,13 +52,11 @@ namespace commandIO {
 	 * \param defs Parameter definitions.
 	 */
 	template <class I>
-	void helpRequired(I &, void (*)(void), Empty) {}
+	void helpRequired(I &, void (*)(void), EmptyC) {}
 
 	// Required parameter.
 	template <class I, class H, class... Tail, class... Args>
-	void helpRequired(
-			I &io, void (*)(H, Tail...),
-			Tuple<Tuple<const char *, const char *>, Args...> &defs) {
+	void helpRequired(I &io, void (*)(H, Tail...), Def<Args...> defs) {
 		H data{};
 		print(
 				io, "  ", defs.head.head, "\t\t", defs.head.tail.head, " (type ",
@@ -48,7 +68,7 @@ namespace commandIO {
 
 	// Skip optional parameter.
 	template <class I, class H, class... Tail, class D>
-	void helpRequired(I &io, void (*)(H, Tail...), D &defs) {
+	void helpRequired(I &io, void (*)(H, Tail...), D const &defs) {
 		void (*f_)(Tail...){};
 		helpRequired(io, f_, defs.tail);
 	}
@@ -64,20 +84,18 @@ namespace commandIO {
 	 * \param defs Parameter definitions.
 	 */
 	template <class I>
-	void helpOptional(I &, void (*)(void), Empty) {}
+	void helpOptional(I &, void (*)(void), EmptyC) {}
 
 	// Skip required parameter.
 	template <class I, class H, class... Tail, class... Args>
-	void helpOptional(
-			I &io, void (*)(H, Tail...),
-			Tuple<Tuple<const char *, const char *>, Args...> &defs) {
+	void helpOptional(I &io, void (*)(H, Tail...), Def<Args...> defs) {
 		void (*f_)(Tail...){};
 		helpOptional(io, f_, defs.tail);
 	}
 
 	// Optional parameter of type `flag`.
 	template <class I, class... Tail, class D>
-	void helpOptional(I &io, void (*)(bool, Tail...), D &defs) {
+	void helpOptional(I &io, void (*)(bool, Tail...), D const &defs) {
 		print(
 				io, "  ", defs.head.head, "\t\t", defs.head.tail.tail.head,
 				" (type flag, default: ", _flagToString(defs.head.tail.head), ")\n");
@@ -88,7 +106,7 @@ namespace commandIO {
 
 	// Optional parameter.
 	template <class I, class H, class... Tail, class D>
-	void helpOptional(I &io, void (*)(H, Tail...), D &defs) {
+	void helpOptional(I &io, void (*)(H, Tail...), D const &defs) {
 		H data{};
 		print(
 				io, "  ", defs.head.head, "\t\t", defs.head.tail.tail.head, " (type ",
@@ -113,7 +131,7 @@ namespace commandIO {
 	// Entry point.
 	template <class I, class R, class... FArgs>
 	void returnType(I &io, R (*)(FArgs...)) {
-		R data{};
+		decay_t<R> data{};
 		print(io, "\nreturns:\n  ", typeOf(data), "\n");
 	}
 
@@ -129,7 +147,9 @@ namespace commandIO {
 	 * \param defs Parameter definitions.
 	 */
 	template <class I, class R, class... FArgs, class D>
-	void help(I &io, R (*f)(FArgs...), string name, string descr, D &defs) {
+	void help(
+			I &io, R (*f)(FArgs...), string_view name, string_view descr,
+			D const &defs) {
 		print(io, name, ": ", descr, "\n");
 
 		int req;
@@ -138,13 +158,13 @@ namespace commandIO {
 
 		if (req) {
 			print(io, "\npositional arguments:\n");
-			void (*f_)(FArgs...){};
+			void (*f_)(decay_t<FArgs>...){};
 			helpRequired(io, f_, defs);
 		}
 
 		if (opt) {
 			print(io, "\noptional arguments:\n");
-			void (*f_)(FArgs...){};
+			void (*f_)(decay_t<FArgs>...){};
 			helpOptional(io, f_, defs);
 		}
 
@@ -157,36 +177,34 @@ namespace commandIO {
 	 * \ingroup help
 	 *
 	 * \param io Input / output object.
-	 * \param m Tuple containing pointers to a class instance and a class member
-	 *   function.
+	 * \param m Tuple containing a class instance and a pointer to a class
+	 *   member function.
 	 * \param name Command name.
 	 * \param descr Command description.
 	 * \param defs Parameter definitions.
 	 */
-	template <class I, class C, class R, class P, class... FArgs, class D>
+	template <class I, class O, class R, class P, class... FArgs, class D>
 	void help(
-			I &io, Tuple<C *, R (P::*)(FArgs...)>,
-			string name, string descr, D &defs) {
+			I &io, Tuple<O, R (P::*)(FArgs...)> const &,
+			string_view name, string_view descr, D const &defs) {
 		R (*f_)
 		(FArgs...){};
 		help(io, f_, name, descr, defs);
 	}
 
-	/**
-	 * Select a command for help.
-	 *
-	 * \fn selectHelp(string, H, Tail...)
-	 * \ingroup help
-	 *
-	 * \param io Input / output object.
-	 * \param name Command name.
-	 * \param t Function definition under consideration.
-	 * \param args Remaining function definitions.
-	 *
-	 * \return `true` on success, `false` otherwise.
-	 */
+	template <class I, class O, class R, class P, class... FArgs, class D>
+	void help(
+			I &io, Tuple<O, R (P::*)(FArgs...) const> const &,
+			string_view name, string_view descr, D const &defs) {
+		R (*f_)
+		(FArgs...){};
+		help(io, f_, name, descr, defs);
+	}
+
+	// Help on a built in command.
 	template <class I>
-	bool selectHelp(I &io, string name) {
+	bool _helpBuiltin(I &io, string_view name) {
+		unsigned builtins{ builtins_(io, 0) };
 		bool result{ true };
 
 		if (name == "help") {
@@ -195,8 +213,35 @@ namespace commandIO {
 					"  name\t\tcommand name (type string)\n");
 		} else if (io.interactive && name == "exit") {
 			print(io, name, ": ", exitHelp);
+		} else if (name == "bg" and builtins & Builtin::JOBS) {
+			print(
+					io, name, ": ", bgHelp, "\npositional arguments:\n",
+					"  command\t\tcommand and its parameters (type string)\n");
+		} else if (name == "map" and builtins & Builtin::MAP) {
+			print(
+					io, name, ": ", mapHelp, "\npositional arguments:\n",
+					"  command\t\tcommand name (type string)\n",
+					"  args\t\toptional arguments followed by one value per required ",
+					"parameter for every call (type string)\n");
+		} else if (name == "stats" and builtins & Builtin::STATS) {
+			print(io, name, ": ", statsHelp);
+		} else if (name == "profile" and builtins & Builtin::PROFILE) {
+			print(
+					io, name, ": ", profileHelp, "\npositional arguments:\n",
+					"  command\t\tcommand and its parameters (type string)\n",
+					"\noptional arguments:\n",
+					"  -n\t\tnumber of runs (type ", typeOf(profileRuns),
+					", default: ", profileRuns, ")\n");
+		} else if (name == "jobs" and builtins & Builtin::JOBS) {
+			print(io, name, ": ", jobsHelp);
+		} else if (
+				(name == "wait" or name == "result") and builtins & Builtin::JOBS) {
+			print(
+					io, name, ": ", name == "wait" ? waitHelp : resultHelp,
+					"\npositional arguments:\n", "  id\t\tjob id (type ",
+					typeOf(size_t{}), ")\n");
 		} else {
-			print(io, "Unknown command: ", name, "\n");
+			print(io, errorMessages[Error::UNKNOWN_COMMAND], name, "\n");
 			result = false;
 		}
 
@@ -205,29 +250,76 @@ namespace commandIO {
 		return result;
 	}
 
-	// Entry point.
-	template <class I, class H, class... Tail>
-	bool selectHelp(I &io, string name, H t, Tail... args) {
-		if (t.tail.head == name) {
-			help(io, t.head, t.tail.head, t.tail.tail.head, t.tail.tail.tail);
-			return true;
+	// Help on function definition `N`.
+	template <class I, class D, size_t N>
+	void _helpAt(I &io, D const &defs) {
+		auto const &def{ get<N>(defs) };
+		help(io, def.head, def.tail.head, def.tail.tail.head, def.tail.tail.tail);
+	}
+
+	// Jump table of `_helpAt()` instances.
+	template <class I, class D, size_t... Is>
+	void _selectHelp(I &io, size_t index, D const &defs, index_sequence<Is...>) {
+		static constexpr array<void (*)(I &, D const &), sizeof...(Is)> thunks{
+			_helpAt<I, D, Is>... };
+		thunks[index](io, defs);
+	}
+
+	/**
+	 * Select a command for help.
+	 *
+	 * \ingroup help
+	 *
+	 * \param io Input / output object.
+	 * \param name Command name.
+	 * \param defs Function definitions.
+	 * \param table Command table of `defs`.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <class I, class... Defs, size_t N>
+	bool selectHelp(
+			I &io, string_view name, Tuple<Defs...> const &defs,
+			Table<N> const &table) {
+		size_t index{ table.find(name.data(), name.size()) };
+
+		if (index == N) {
+			return _helpBuiltin(io, name);
 		}
 
-		return selectHelp(io, name, args...);
+		_selectHelp(io, index, defs, index_sequence_for<Defs...>{});
+		return true;
 	}
 
 	/**
 	 * Short description of all available functions.
 	 *
-	 * \fn describe(Args...)
+	 * \fn describe(Tuple<Args...>&)
 	 * \ingroup help
 	 *
 	 * \param io Input / output object.
-	 * \param args Function definitions.
+	 * \param defs Function definitions.
 	 */
 	template <class I>
-	void _describe(I &io) {
+	void _describe(I &io, EmptyC) {
+		unsigned builtins{ builtins_(io, 0) };
+
 		print(io, "  help\t\t", helpHelp);
+		if (builtins & Builtin::STATS) {
+			print(io, "  stats\t\t", statsHelp);
+		}
+		if (builtins & Builtin::MAP) {
+			print(io, "  map\t\t", mapHelp);
+		}
+		if (builtins & Builtin::PROFILE) {
+			print(io, "  profile\t\t", profileHelp);
+		}
+		if (builtins & Builtin::JOBS) {
+			print(io, "  bg\t\t", bgHelp);
+			print(io, "  jobs\t\t", jobsHelp);
+			print(io, "  wait\t\t", waitHelp);
+			print(io, "  result\t\t", resultHelp);
+		}
 		if (io.interactive) {
 			print(io, "  exit\t\t", exitHelp);
 		}
@@ -236,15 +328,17 @@ namespace commandIO {
 
 	// Short description of one function.
 	template <class I, class H, class... Tail>
-	void _describe(I &io, H t, Tail... args) {
-		print(io, "  ", t.tail.head, "\t\t", t.tail.tail.head, "\n");
-		_describe(io, args...);
+	void _describe(I &io, Tuple<H, Tail...> const &defs) {
+		print(
+				io, "  ", defs.head.tail.head, "\t\t", defs.head.tail.tail.head,
+				"\n");
+		_describe(io, defs.tail);
 	}
 
 	// Entry point.
-	template <class I, class... Args>
-	void describe(I &io, Args... args) {
+	template <class I, class D>
+	void describe(I &io, D const &defs) {
 		print(io, "Available commands:\n");
-		_describe(io, args...);
+		_describe(io, defs);
 	}
 }
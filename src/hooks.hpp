@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "error.hpp"
+
+namespace commandIO {
+
+	/// \defgroup hooks
+
+	using std::string_view;
+	using std::uint64_t;
+
+	/*!
+	 * Result of a function that returns nothing.
+	 *
+	 * \ingroup hooks
+	 */
+	struct Void {};
+
+	/*!
+	 * Hook policy that does nothing.
+	 *
+	 * A hook policy is a class with the static members below, it is passed
+	 * as a template parameter to `parse()`, `select()`, `commandInterface()`
+	 * and `BasicInterface`, e.g., to add tracing, auditing or argument
+	 * validation. Derive from `NoHooks` and hide the members that are
+	 * needed, the calls of the others compile away.
+	 *
+	 * \ingroup hooks
+	 */
+	struct NoHooks {
+		static constexpr bool timed{ false }; ///< Time calls for `afterCall()`.
+
+		/*!
+		 * Called for every argument token that is read.
+		 *
+		 * \param token Token.
+		 */
+		static void onToken(string_view) {}
+
+		/*!
+		 * Called when all arguments are converted.
+		 *
+		 * \param name Command name.
+		 * \param argv Tuple containing the arguments.
+		 *
+		 * \return `false` to reject the arguments, the command then fails.
+		 */
+		template <class A>
+		static bool beforeCall(char const *, A const &) {
+			return true;
+		}
+
+		/*!
+		 * Called when a function has returned.
+		 *
+		 * \param name Command name.
+		 * \param result Return value, `Void` for functions that return
+		 *   nothing or a task.
+		 * \param duration Ticks spent in the function if `timed` is set, see
+		 *   `ticks()`, 0 otherwise.
+		 */
+		template <class R>
+		static void afterCall(char const *, R const &, uint64_t) {}
+
+		/*!
+		 * Called when an argument cannot be used.
+		 *
+		 * \param error Error code.
+		 */
+		static void onError(Error) {}
+	};
+}
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#include "input.hpp"
+#include "stats.hpp"
+
+namespace commandIO {
+
+	static size_t const chunkSize_{ 65536 };
+
+	InputBuffer::InputBuffer(size_t maxLine, Kernel kernel)
+			: maxLine{ maxLine },
+				classify_{ classifier(std::min(kernel, bestKernel())) } {}
+
+	bool InputBuffer::receive(int fd) {
+		compact_();
+
+		while (line_ == lines_.size()) {
+			if (size_ < end_ + chunkSize_) {
+				storage_.resize(std::max(2 * size_, end_ + chunkSize_));
+				data_ = storage_.data();
+				size_ = storage_.size();
+			}
+
+			ssize_t size{ ::read(fd, data_ + end_, size_ - end_) };
+
+			if (size > 0) {
+				Stats::read(size);
+				end_ += size;
+				tokenize_();
+			} else if (not size) {
+				finish_();
+				return false;
+			} else if (errno != EINTR) {
+				return errno == EAGAIN or errno == EWOULDBLOCK;
+			}
+		}
+
+		return true;
+	}
+
+	void InputBuffer::assign(char *data, size_t size) {
+		data_ = data;
+		size_ = size;
+		external_ = true;
+	}
+
+	bool InputBuffer::receive() {
+		compact_();
+
+		while (line_ == lines_.size()) {
+			if (end_ == size_) {
+				finish_();
+				return false;
+			}
+			Stats::read(std::min(size_, end_ + chunkSize_) - end_);
+			end_ = std::min(size_, end_ + chunkSize_);
+			tokenize_();
+		}
+
+		return true;
+	}
+
+	size_t InputBuffer::next() {
+		token_ = tokenEnd_;
+
+		if (line_ == lines_.size()) {
+			return 0;
+		}
+
+		tokenEnd_ = lines_[line_];
+		number_ = numbers_[line_];
+		line_++;
+
+		return tokenEnd_ - token_;
+	}
+
+	bool InputBuffer::eol() const {
+		return token_ == tokenEnd_;
+	}
+
+	void InputBuffer::flush() {
+		token_ = tokenEnd_;
+	}
+
+	string_view InputBuffer::read() {
+		if (eol()) {
+			return {};
+		}
+
+		Token const &token{ tokens_[token_++] };
+		Stats::token();
+		return { data_ + token.offset, token.size };
+	}
+
+	string_view InputBuffer::back() const {
+		if (not tokenEnd_) {
+			return {};
+		}
+
+		Token const &token{ tokens_[tokenEnd_ - 1] };
+		return { data_ + token.offset, token.size };
+	}
+
+	size_t InputBuffer::line() const {
+		return number_;
+	}
+
+	bool InputBuffer::overflow() {
+		bool result{ overflow_ };
+		overflow_ = false;
+		return result;
+	}
+
+	/*
+	 * Drop consumed lines once all complete lines have been consumed and move
+	 * the incomplete line to the start of the buffer, assigned memory is not
+	 * moved.
+	 */
+	void InputBuffer::compact_() {
+		if (line_ != lines_.size()) {
+			return;
+		}
+
+		tokens_.erase(tokens_.begin(), tokens_.begin() + lineToken_);
+		lines_.clear();
+		numbers_.clear();
+		line_ = 0;
+		token_ = 0;
+		tokenEnd_ = 0;
+		lineToken_ = 0;
+
+		if (external_) {
+			return;
+		}
+
+		for (Token &token: tokens_) {
+			token.offset -= lineOut_;
+		}
+
+		// Everything received has been tokenized, so `read_` equals `end_`.
+		memmove(data_, data_ + lineOut_, write_ - lineOut_);
+		tokenStart_ -= lineOut_;
+		write_ -= lineOut_;
+		read_ = write_;
+		end_ = write_;
+		lineOut_ = 0;
+	}
+
+	// Terminate an incomplete last line.
+	void InputBuffer::finish_() {
+		if (not discard_) {
+			split_();
+			endLine_();
+		}
+	}
+
+	/*
+	 * Tokenize all received data. Output is written in place, the write
+	 * position never overtakes the read position.
+	 */
+	void InputBuffer::tokenize_() {
+		while (read_ < end_) {
+			if (
+					classify_ and end_ - read_ >= blockSize and
+					not(escape_ or quoted_ or discard_) and scan_()) {
+				continue;
+			}
+			step_(data_[read_++]);
+		}
+	}
+
+	/*
+	 * Tokenize the start of a block up to the first quote or backslash.
+	 *
+	 * Separators are left in place, so the output has the same layout as the
+	 * input.
+	 */
+	size_t InputBuffer::scan_() {
+		Masks masks{ classify_(data_ + read_) };
+		size_t size{
+			masks.special ? size_t(__builtin_ctz(masks.special)) : blockSize };
+
+		if (not size or (maxLine and lineBytes_ + size > maxLine)) {
+			return 0;
+		}
+
+		uint32_t keep{ size == blockSize ? ~0u : (1u << size) - 1 };
+		uint32_t boundary{ (masks.separator | masks.newline) & keep };
+		uint32_t newline{ masks.newline & keep };
+		size_t base{ write_ };
+		size_t position{ 0 };
+
+		if (base != read_) {
+			memmove(data_ + base, data_ + read_, size);
+		}
+
+		while (boundary) {
+			size_t end{ size_t(__builtin_ctz(boundary)) };
+			boundary &= boundary - 1;
+
+			if (end > position and not inToken_) {
+				tokenStart_ = base + position;
+				inToken_ = true;
+			}
+			write_ = base + end;
+			split_();
+			write_ = base + end + 1;
+			if (newline >> end & 1) {
+				newlines_++;
+				endLine_();
+			}
+			position = end + 1;
+		}
+
+		if (position < size and not inToken_) {
+			tokenStart_ = base + position;
+			inToken_ = true;
+		}
+		write_ = base + size;
+		read_ += size;
+
+		if (maxLine) {
+			lineBytes_ += size - (newline ? blockSize - __builtin_clz(newline) : 0);
+		}
+
+		return size;
+	}
+
+	// Tokenize one byte.
+	void InputBuffer::step_(char c) {
+		if (c == '\n') {
+			newlines_++;
+		}
+
+		if (discard_) {
+			if (c == '\n') {
+				discard_ = false;
+				lineBytes_ = 0;
+				lineNumber_ = newlines_ + 1;
+			}
+			return;
+		}
+
+		if (maxLine and c != '\n' and ++lineBytes_ > maxLine) {
+			tokens_.resize(lineToken_);
+			write_ = lineOut_;
+			inToken_ = false;
+			escape_ = false;
+			quoted_ = false;
+			discard_ = true;
+			overflow_ = true;
+			return;
+		}
+
+		if (escape_) {
+			store_(c);
+			escape_ = false;
+			return;
+		}
+
+		switch (c) {
+			case '\\':
+				escape_ = true;
+				break;
+			case '"':
+				quoted_ = not quoted_;
+				break;
+			case ' ':
+			case '\t':
+				if (not quoted_) {
+					split_();
+				} else {
+					store_(c);
+				}
+				break;
+			case '\n':
+				split_();
+				endLine_();
+				break;
+			default:
+				store_(c);
+		}
+	}
+
+	void InputBuffer::store_(char c) {
+		if (not inToken_) {
+			tokenStart_ = write_;
+			inToken_ = true;
+		}
+		data_[write_++] = c;
+	}
+
+	void InputBuffer::split_() {
+		if (inToken_) {
+			tokens_.push_back({ tokenStart_, write_ - tokenStart_ });
+			inToken_ = false;
+		}
+	}
+
+	void InputBuffer::endLine_() {
+		if (tokens_.size() > lineToken_) {
+			lines_.push_back(tokens_.size());
+			numbers_.push_back(lineNumber_);
+		}
+		lineNumber_ = newlines_ + 1;
+		lineToken_ = tokens_.size();
+		lineOut_ = write_;
+		lineBytes_ = 0;
+		escape_ = false;
+		quoted_ = false;
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "classify.hpp"
+
+namespace commandIO {
+
+	using std::size_t;
+	using std::string_view;
+	using std::vector;
+
+	/*!
+	 * Line buffered input.
+	 *
+	 * Input is read in large chunks and tokenized in place, backslash escapes
+	 * and quotes are removed and tokens are kept as spans into the buffer.
+	 * Instead of reading from a file descriptor, a region of writable memory
+	 * can be tokenized.
+	 *
+	 * Runs of input without quotes or backslashes are classified a block at a
+	 * time, the remainder is handled by a byte at a time state machine.
+	 */
+	class InputBuffer {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param maxLine Maximum line length in bytes, 0 for no limit. Longer
+		 *   lines are discarded up to the next line ending.
+		 * \param kernel Tokenizer kernel, the best supported kernel is used if
+		 *   the requested one is not available.
+		 */
+		InputBuffer(size_t maxLine = 0, Kernel kernel = bestKernel());
+
+		/*!
+		 * Read all pending data from a file descriptor.
+		 *
+		 * Reading stops when the descriptor would block, at the end of the
+		 * input or when at least one complete line is available.
+		 *
+		 * \param fd File descriptor.
+		 *
+		 * \return `false` if the end of the input was reached, `true` otherwise.
+		 */
+		bool receive(int);
+
+		/*!
+		 * Use a region of memory as input.
+		 *
+		 * The region is tokenized in place, so it must be writable and must
+		 * stay valid for the lifetime of the buffer. This function must be
+		 * called before any input is received.
+		 *
+		 * \param data Memory region.
+		 * \param size Size of `data`.
+		 */
+		void assign(char *, size_t);
+
+		/*!
+		 * Tokenize assigned memory until at least one complete line is
+		 * available.
+		 *
+		 * \return `false` if the end of the input was reached, `true` otherwise.
+		 */
+		bool receive();
+
+		/*!
+		 * Skip to the next complete line.
+		 *
+		 * \return Number of tokens in the line, 0 if no line is available.
+		 */
+		size_t next();
+
+		/*!
+		 * Check whether a line ending was encountered.
+		 *
+		 * \return `true` if a line ending was encountered, `false` otherwise.
+		 */
+		bool eol() const;
+
+		/*!
+		 * Discard the remainder of the current line.
+		 */
+		void flush();
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Line number of the current line.
+		 *
+		 * \return Line number of the first line ending of the current line.
+		 */
+		size_t line() const;
+
+		/*!
+		 * Check whether a line was discarded for being too long.
+		 *
+		 * \return `true` if a line was discarded since the last call, `false`
+		 *   otherwise.
+		 */
+		bool overflow();
+
+		size_t const maxLine;
+
+	private:
+		struct Token {
+			size_t offset;
+			size_t size;
+		};
+
+		void compact_();
+		void finish_();
+		void tokenize_();
+		size_t scan_();
+		void step_(char);
+		void store_(char);
+		void split_();
+		void endLine_();
+
+		Classifier const classify_;
+		vector<char> storage_;
+		char *data_{ nullptr };
+		size_t size_{ 0 }; ///< Size of `data_`.
+		bool external_{ false }; ///< `data_` is assigned memory.
+		vector<Token> tokens_;
+		vector<size_t> lines_; ///< Token index past the end of each line.
+		vector<size_t> numbers_; ///< Line number of each line.
+		size_t read_{ 0 }; ///< Next byte to tokenize.
+		size_t write_{ 0 }; ///< Next byte of tokenized output.
+		size_t end_{ 0 }; ///< End of received data.
+		size_t line_{ 0 }; ///< Next line in `lines_`.
+		size_t token_{ 0 }; ///< Next token of the current line.
+		size_t tokenEnd_{ 0 }; ///< End of the current line.
+		size_t lineToken_{ 0 }; ///< First token of the incomplete line.
+		size_t lineOut_{ 0 }; ///< First output byte of the incomplete line.
+		size_t lineBytes_{ 0 }; ///< Input bytes of the incomplete line.
+		size_t newlines_{ 0 }; ///< Line endings seen.
+		size_t lineNumber_{ 1 }; ///< Line number of the incomplete line.
+		size_t number_{ 0 }; ///< Line number of the current line.
+		size_t tokenStart_{ 0 };
+		bool inToken_{ false };
+		bool escape_{ false };
+		bool quoted_{ false };
+		bool discard_{ false };
+		bool overflow_{ false };
+	};
+}
@@ -1,20 +1,37 @@
 #pragma once
 
-#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "builtins.hpp"
 #include "eval.hpp"
 #include "help.hpp"
+#include "jobs.hpp"
+#include "map.hpp"
+#include "plugins/memory/io.hpp"
 #include "tuple.hpp"
 
 namespace commandIO {
 
 	/// \defgroup interface
 
+	using std::condition_variable;
+	using std::mutex;
+	using std::string;
+	using std::unordered_map;
+	using std::vector;
+
 	/**
 	 * Build a user interface for one function.
 	 *
 	 * \ingroup interface
 	 *
+	 * \tparam H Hook policy.
+	 *
 	 * \param io Input / output object.
 	 * \param f Function pointer.
 	 * \param name Command name.
@@ -23,15 +40,554 @@ namespace commandIO {
 	 *
 	 * \return `true` to continue `false` to quit.
 	 */
-	template <class I, class F, class T, class... Args>
-	bool commandInterface(I& io, F f, T name, const char* descr, Args... defs) {
-	  Tuple<Args...> t {pack(defs...)};
+	template <class H = NoHooks, class I, class F, class T, class... Args>
+	bool commandInterface(I &io, F f, T name, const char *descr, Args... defs) {
+		Tuple<Args...> t{ pack(defs...) };
+
+		bool success{ parse<H>(io, f, t, name) };
 
-	  if (not parse(io, f, t)) {
-	    help(io, f, name, descr, t);
-	  }
+		if (not success) {
+			help(io, f, name, descr, t);
+		}
+		io.endCommand(success);
 
-	  return true;
+		return true;
+	}
+
+	/**
+	 * User interface for multiple functions.
+	 *
+	 * The function definitions are packed once at construction, an interface
+	 * can therefore be declared `static` or `constexpr` and reused for every
+	 * command. Commands are looked up in a hash table that is also built at
+	 * construction.
+	 *
+	 * The built in command `map` runs one command for many argument sets,
+	 * `stats` shows the statistics collected by `Stats` and `profile` runs
+	 * one command many times to show where its time goes.
+	 *
+	 * A command prefixed with `bg` or ending in `&` runs as a background job
+	 * of the session, the built in commands `jobs`, `wait` and `result` show
+	 * the state and output of these jobs.
+	 *
+	 * Built in commands that an input / output object does not support, see
+	 * `Builtin`, are not available. Every command goes through the hook
+	 * policy `H`, see `NoHooks`.
+	 *
+	 * \ingroup interface
+	 *
+	 * \tparam H Hook policy.
+	 * \tparam Defs Function definitions.
+	 */
+	template <class H, class... Defs>
+	class BasicInterface {
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * \param defs Function definitions.
+		 */
+		constexpr BasicInterface(Defs... defs)
+				: defs_{ pack(defs...) }, table_{ defs_ } {}
+
+		/**
+		 * Handle one command.
+		 *
+		 * \param io Input / output object.
+		 *
+		 * \return `true` to continue `false` to quit.
+		 */
+		template <class I>
+		bool step(I &io) const {
+			string_view command;
+
+			if (io.interactive and io.session.prompt) {
+				print(io, "> ");
+				io.session.prompt = false;
+			}
+
+			if (io.available()) {
+				command = io.read();
+				io.session.prompt = true;
+
+				if (command == "exit") {
+					return false;
+				}
+				io.endCommand(dispatch_(io, command));
+
+				return true;
+			}
+
+			return io.wait();
+		}
+
+		/**
+		 * Handle commands until the user quits or the input is closed.
+		 *
+		 * \param io Input / output object.
+		 */
+		template <class I>
+		void run(I &io) const {
+			while (step(io)) {}
+		}
+
+		/**
+		 * Handle all commands in parallel on a thread pool.
+		 *
+		 * Commands are read until the input ends or `exit` is read. A line
+		 * with only `barrier` waits for all earlier commands before a later
+		 * command starts, commands on the same class instance run in input
+		 * order. The output of the commands is written in input order. The
+		 * built in commands are available except for job control.
+		 *
+		 * \param io Input / output object.
+		 * \param pool Thread pool.
+		 */
+		template <class I>
+		void batch(I &io, ThreadPool &pool = ThreadPool::shared()) const {
+			vector<Command_> commands;
+			bool open{ true };
+
+			while (open) {
+				while (open and io.available()) {
+					Command_ command;
+
+					while (not io.eol()) {
+						command.tokens.emplace_back(io.read());
+					}
+					command.line = line_(io, 0);
+
+					if (command.tokens[0] == "exit") {
+						open = false;
+					} else if (
+							command.tokens[0] == "barrier" and command.tokens.size() == 1) {
+						stage_(io, commands, pool);
+						commands.clear();
+					} else {
+						commands.push_back(std::move(command));
+					}
+				}
+				open = open and io.wait();
+			}
+			stage_(io, commands, pool);
+		}
+
+		/**
+		 * Run one command for many argument sets.
+		 *
+		 * The command is looked up once, `args` holds the optional arguments
+		 * for all calls followed by one value per required parameter for
+		 * every call. A function with a batch overload is called once.
+		 *
+		 * \param io Input / output object.
+		 * \param name Command name.
+		 * \param args Arguments.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		template <class I>
+		bool map(I &io, string_view name, vector<string_view> const &args) const {
+			Tokens input{ args };
+			return selectMap<H>(io, input, name, defs_, table_);
+		}
+
+	private:
+		/*
+		 * Run a built in or user command. Built in commands that the input /
+		 * output object does not support are looked up as user commands, job
+		 * control is rejected.
+		 */
+		template <class I>
+		bool dispatch_(I &io, string_view command) const {
+			unsigned builtins{ builtins_(io, 0) };
+			bool job{ command == "bg" or io.back() == "&" };
+
+			if (
+					not(builtins & Builtin::JOBS) and
+					(job or command == "jobs" or command == "wait" or
+					 command == "result")) {
+				print(io, "Job control is not available here.\n");
+				io.flush();
+				return false;
+			}
+
+			if (job) {
+				return background_(io, command);
+			}
+			if (command == "help") {
+				if (io.eol() or not selectHelp(io, io.read(), defs_, table_)) {
+					describe(io, defs_);
+				}
+			} else if (command == "stats" and builtins & Builtin::STATS) {
+				print(io, Stats::report());
+			} else if (command == "map" and builtins & Builtin::MAP) {
+				return map_(io);
+			} else if (command == "profile" and builtins & Builtin::PROFILE) {
+				return profile_(io);
+			} else if (command == "jobs") {
+				print(io, io.session.jobs().list());
+			} else if (command == "wait") {
+				return wait_(io);
+			} else if (command == "result") {
+				return result_(io);
+			} else if (not select<H>(io, command, defs_, table_)) {
+				describe(io, defs_);
+				return false;
+			}
+
+			return true;
+		}
+
+		// Run the rest of the line for many argument sets.
+		template <class I>
+		bool map_(I &io) const {
+			if (io.eol()) {
+				print(io, "Missing command.\n");
+				return false;
+			}
+			if (not selectMap<H>(io, io, io.read(), defs_, table_)) {
+				describe(io, defs_);
+				return false;
+			}
+			return true;
+		}
+
+		/*
+		 * Run the rest of the line many times. Each run goes through the same
+		 * lookup and parsing as a normal command, its output is discarded
+		 * unless it fails.
+		 */
+		template <class I>
+		bool profile_(I &io) const {
+			using Clock = std::chrono::steady_clock;
+
+			size_t runs{ profileRuns };
+			vector<string> tokens;
+			vector<uint64_t> times;
+			Phases phases;
+			PerfCounters counters;
+
+			while (not io.eol()) {
+				tokens.emplace_back(io.read());
+			}
+			if (tokens.size() and tokens[0] == "-n") {
+				if (
+						tokens.size() < 2 or convert(&runs, tokens[1]) != Error::SUCCESS or
+						not runs) {
+					print(io, "Invalid number of runs.\n");
+					return false;
+				}
+				tokens.erase(tokens.begin(), tokens.begin() + 2);
+			}
+			if (tokens.empty()) {
+				print(io, "Missing command.\n");
+				return false;
+			}
+
+			// The runs would distort the statistics of the command.
+			times.reserve(runs);
+			Stats::suspend(true);
+			for (size_t i{ 0 }; i < runs; i++) {
+				MemoryIO job(tokens, io.session);
+				string_view name{ job.read() };
+
+				Profile::attach(&phases);
+				counters.start();
+				Clock::time_point start{ Clock::now() };
+				uint64_t begin{ ticks() };
+				bool success{ select<H>(job, name, defs_, table_) };
+				phases.total += ticks() - begin;
+				times.push_back(uint64_t(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(
+								Clock::now() - start)
+								.count()));
+				counters.stop();
+				Profile::attach(nullptr);
+
+				job.wait();
+				if (not success) {
+					Stats::suspend(false);
+					describe(job, defs_);
+					print(io, job.output);
+					return false;
+				}
+			}
+			Stats::suspend(false);
+			print(io, profileReport(tokens[0], times, phases, counters));
+
+			return true;
+		}
+
+		// Run the rest of the line as a background job.
+		template <class I>
+		bool background_(I &io, string_view command) const {
+			vector<string> tokens;
+			string line;
+
+			if (command != "bg") {
+				tokens.emplace_back(command);
+			}
+			while (not io.eol()) {
+				tokens.emplace_back(io.read());
+			}
+			if (tokens.size() and tokens.back() == "&") {
+				tokens.pop_back();
+			}
+			if (tokens.empty()) {
+				print(io, "Missing command.\n");
+				return false;
+			}
+
+			for (string const &token: tokens) {
+				line += (line.empty() ? "" : " ") + token;
+			}
+			size_t id{ io.session.jobs().start(
+					line, [interface{ *this }, tokens, &session{ io.session }](
+										string &output) {
+						return interface.run_(tokens, session, output);
+					}) };
+			print(io, "[", id, "]\n");
+
+			return true;
+		}
+
+		// Read a job id.
+		template <class I>
+		bool jobId_(I &io, size_t &id) const {
+			if (io.eol() or convert(&id, io.read()) != Error::SUCCESS) {
+				print(io, "Job id missing.\n");
+				io.flush();
+				return false;
+			}
+			return true;
+		}
+
+		// Wait for a job.
+		template <class I>
+		bool wait_(I &io) const {
+			size_t id;
+
+			if (not jobId_(io, id)) {
+				return false;
+			}
+
+			Status status{ io.session.jobs().wait(id) };
+			if (status == Status::UNKNOWN) {
+				print(io, "Unknown job: ", id, "\n");
+				return false;
+			}
+			print(io, "[", id, "] ", statusNames[status], "\n");
+
+			return true;
+		}
+
+		// Show the output of a finished job.
+		template <class I>
+		bool result_(I &io) const {
+			size_t id;
+			string output;
+
+			if (not jobId_(io, id)) {
+				return false;
+			}
+
+			Status status{ io.session.jobs().result(id, output) };
+			switch (status) {
+				case Status::UNKNOWN:
+					print(io, "Unknown job: ", id, "\n");
+					return false;
+				case Status::RUNNING:
+					print(io, "[", id, "] ", statusNames[status], "\n");
+					break;
+				default:
+					print(io, output);
+			}
+
+			return true;
+		}
+
+		static constexpr size_t grain_{ 64 };
+
+		struct Command_ {
+			vector<string> tokens;
+			size_t line;
+			string output;
+			bool success;
+		};
+
+		/*
+		 * Run one command and capture its output. Job control is left out, the
+		 * command runs on the pool itself and waiting for another job could
+		 * block the threads that job needs.
+		 */
+		bool run_(vector<string> tokens, Session &session, string &output) const {
+			MemoryIO io(std::move(tokens), session);
+
+			io.builtins &= ~Builtin::JOBS;
+			bool success{ dispatch_(io, io.read()) };
+
+			io.wait();
+			output = std::move(io.output);
+
+			return success;
+		}
+
+		/*
+		 * Run commands in parallel, commands on the same instance form a chain
+		 * that runs in order. Other commands are grouped in chains of up to
+		 * `grain_` commands to keep the scheduling overhead low. Output is
+		 * written once all commands are done.
+		 */
+		template <class I>
+		void stage_(I &io, vector<Command_> &commands, ThreadPool &pool) const {
+			unordered_map<void const *, size_t> chainOf;
+			vector<vector<size_t>> chains;
+			size_t remaining;
+			mutex access;
+			condition_variable done;
+
+			for (size_t i{ 0 }; i < commands.size(); i++) {
+				void const *object{ key_(target_(commands[i].tokens)) };
+				auto chain{ chainOf.find(object) };
+
+				if (
+						chain != chainOf.end() and
+						(object or chains[chain->second].size() < grain_)) {
+					chains[chain->second].push_back(i);
+					continue;
+				}
+				chainOf[object] = chains.size();
+				chains.push_back({ i });
+			}
+
+			remaining = chains.size();
+			for (vector<size_t> const &chain: chains) {
+				pool.submit([&]() {
+					for (size_t i: chain) {
+						Command_ &command{ commands[i] };
+						command.success =
+								run_(std::move(command.tokens), io.session, command.output);
+					}
+
+					// Count under the lock, the waiter destroys it when done.
+					std::lock_guard<mutex> guard{ access };
+					if (not --remaining) {
+						done.notify_all();
+					}
+				});
+			}
+
+			std::unique_lock<mutex> lock{ access };
+			done.wait(lock, [&]() { return not remaining; });
+
+			for (Command_ &command: commands) {
+				io.write(command.output);
+				endCommand_(io, command.success, command.line, 0);
+			}
+		}
+
+		// Command run by a line, built in commands run the command they name.
+		static string_view target_(vector<string> const &tokens) {
+			size_t index{ 0 };
+
+			if (tokens[0] == "map" or tokens[0] == "bg") {
+				index = 1;
+			} else if (tokens[0] == "profile") {
+				index = tokens.size() > 1 and tokens[1] == "-n" ? 3 : 1;
+			}
+			return index < tokens.size() ? tokens[index] : tokens[0];
+		}
+
+		// Instance used by a command, `nullptr` for functions.
+		void const *key_(string_view name) const {
+			size_t index{ table_.find(name.data(), name.size()) };
+
+			if (index == sizeof...(Defs)) {
+				return nullptr;
+			}
+			return keys_(index, index_sequence_for<Defs...>{});
+		}
+
+		template <size_t... Is>
+		void const *keys_(size_t index, index_sequence<Is...>) const {
+			static constexpr array<
+					void const *(*)(Tuple<Defs...> const &), sizeof...(Is)>
+					thunks{ keyAt_<Is>... };
+			return thunks[index](defs_);
+		}
+
+		template <size_t N>
+		static void const *keyAt_(Tuple<Defs...> const &defs) {
+			return keyOf_(get<N>(defs).head);
+		}
+
+		template <class F>
+		static void const *keyOf_(F const &) {
+			return nullptr;
+		}
+
+		template <class O, class M>
+		static void const *keyOf_(Tuple<O, M> const &m) {
+			return key(m.head);
+		}
+
+		// Line number of the current command, if the input has line numbers.
+		template <class I>
+		static auto line_(I &io, int) -> decltype(size_t(io.line())) {
+			return io.line();
+		}
+
+		template <class I>
+		static size_t line_(I &, long) {
+			return 0;
+		}
+
+		// End a command that was read earlier, on line `line`.
+		template <class I>
+		static auto endCommand_(I &io, bool success, size_t line, int)
+				-> decltype(io.endCommand(success, line)) {
+			io.endCommand(success, line);
+		}
+
+		template <class I>
+		static void endCommand_(I &io, bool success, size_t, long) {
+			io.endCommand(success);
+		}
+
+		Tuple<Defs...> defs_;
+		Table<sizeof...(Defs)> table_;
+	};
+
+	/**
+	 * User interface for multiple functions without hooks.
+	 *
+	 * \ingroup interface
+	 *
+	 * \tparam Defs Function definitions.
+	 */
+	template <class... Defs>
+	class Interface : public BasicInterface<NoHooks, Defs...> {
+	public:
+		using BasicInterface<NoHooks, Defs...>::BasicInterface;
+	};
+
+	template <class... Defs>
+	Interface(Defs...) -> Interface<Defs...>;
+
+	/**
+	 * Build a user interface whose commands go through a hook policy.
+	 *
+	 * \ingroup interface
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param defs Function definitions.
+	 *
+	 * \return User interface.
+	 */
+	template <class H, class... Defs>
+	constexpr BasicInterface<H, Defs...> hookedInterface(Defs... defs) {
+		return BasicInterface<H, Defs...>(defs...);
 	}
 
 	/**
@@ -39,40 +595,15 @@ namespace commandIO {
 	 *
 	 * \ingroup interface
 	 *
+	 * \tparam H Hook policy.
+	 *
 	 * \param io Input / output object.
 	 * \param args Function definitions.
+	 *
+	 * \return `true` to continue `false` to quit.
 	 */
-	template <class I, class... Args>
-	bool commandInterface(I& io, Args... args) {
-	  static bool prompt {true};
-	  string command;
-
-	  if (io.interactive and prompt) {
-	    print(io, "> ");
-	    prompt = false;
-	  }
-
-	  if (io.available()) {
-	    command = io.read();
-	    prompt = true;
-
-	    if (command == "exit") {
-	      return false;
-	    }
-	    if (command == "help") {
-	      if (io.eol() or not selectHelp(io, io.read(), args...)) {
-	        describe(io, args...);
-	      }
-	      return true;
-	    }
-
-	    if (not select(io, command, args...)) {
-	      describe(io, args...);
-	    }
-	  }
-
-	  usleep(10000);
-
-	  return true;
+	template <class H = NoHooks, class I, class... Args>
+	bool commandInterface(I &io, Args... args) {
+		return BasicInterface<H, Args...>(args...).step(io);
 	}
 }
@@ -0,0 +1,210 @@
+#include "jobs.hpp"
+#include "lock.hpp"
+
+namespace commandIO {
+
+	using std::lock_guard;
+	using std::to_string;
+	using std::unique_lock;
+
+	// Pool and queue index of the current worker thread.
+	thread_local ThreadPool *pool_{ nullptr };
+	thread_local size_t worker_;
+
+	ThreadPool::ThreadPool(size_t size) {
+		concurrent();
+		if (not size) {
+			size = std::max(thread::hardware_concurrency(), 1u);
+		}
+		for (size_t i{ 0 }; i < size; i++) {
+			queues_.emplace_back(new Queue_());
+		}
+		for (size_t i{ 0 }; i < size; i++) {
+			threads_.emplace_back(&ThreadPool::work_, this, i);
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			lock_guard<mutex> guard{ mutex_ };
+			stop_ = true;
+		}
+		ready_.notify_all();
+		for (thread &worker: threads_) {
+			worker.join();
+		}
+	}
+
+	void ThreadPool::submit(function<void()> task) {
+		size_t index{
+			pool_ == this ? worker_ : next_.fetch_add(1) % queues_.size() };
+		{
+			lock_guard<mutex> guard{ mutex_ };
+			queued_++;
+		}
+		{
+			lock_guard<mutex> guard{ queues_[index]->access };
+			queues_[index]->tasks.push_back(std::move(task));
+		}
+		ready_.notify_one();
+	}
+
+	size_t ThreadPool::size() const {
+		return threads_.size();
+	}
+
+	size_t ThreadPool::queued() const {
+		return queued_.load(std::memory_order_relaxed);
+	}
+
+	ThreadPool &ThreadPool::shared() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	void ThreadPool::work_(size_t index) {
+		pool_ = this;
+		worker_ = index;
+
+		while (true) {
+			function<void()> task;
+
+			if (take_(index, task)) {
+				task();
+				continue;
+			}
+
+			unique_lock<mutex> lock{ mutex_ };
+			ready_.wait(lock, [this]() { return stop_ or queued_; });
+			if (stop_ and not queued_) {
+				return;
+			}
+		}
+	}
+
+	// Take the newest task of the own queue or steal the oldest of another.
+	bool ThreadPool::take_(size_t index, function<void()> &task) {
+		for (size_t i{ 0 }; i < queues_.size(); i++) {
+			Queue_ &queue{ *queues_[(index + i) % queues_.size()] };
+			lock_guard<mutex> guard{ queue.access };
+
+			if (queue.tasks.empty()) {
+				continue;
+			}
+			if (not i) {
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			} else {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			queued_--;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	Jobs::Jobs(ThreadPool &pool) : pool_{ pool } {}
+
+	Jobs::~Jobs() {
+		unique_lock<mutex> lock{ mutex_ };
+		finished_.wait(lock, [this]() { return not running_; });
+	}
+
+	size_t Jobs::start(string command, function<bool(string &)> task) {
+		shared_ptr<Job_> job{ new Job_{ std::move(command), {} } };
+		size_t id;
+		{
+			lock_guard<mutex> guard{ mutex_ };
+			id = next_++;
+			jobs_[id] = job;
+			running_++;
+		}
+
+		pool_.submit([this, job, task = std::move(task)]() {
+			string output;
+			bool success{ task(output) };
+			lock_guard<mutex> guard{ mutex_ };
+
+			// Notify under the lock, the jobs may be destroyed right after.
+			job->output = std::move(output);
+			job->status = success ? Status::DONE : Status::FAILED;
+			running_--;
+			finished_.notify_all();
+		});
+
+		return id;
+	}
+
+	string Jobs::list() {
+		lock_guard<mutex> guard{ mutex_ };
+		string text;
+
+		for (auto const &[id, job]: jobs_) {
+			text += "[" + to_string(id) + "] " + statusNames[job->status] + "\t" +
+				job->command + "\n";
+		}
+
+		return text;
+	}
+
+	Status Jobs::wait(size_t id) {
+		unique_lock<mutex> lock{ mutex_ };
+		auto found{ jobs_.find(id) };
+
+		if (found == jobs_.end()) {
+			return Status::UNKNOWN;
+		}
+		shared_ptr<Job_> job{ found->second };
+		finished_.wait(lock, [&]() { return job->status != Status::RUNNING; });
+
+		return job->status;
+	}
+
+	Status Jobs::result(size_t id, string &output) {
+		lock_guard<mutex> guard{ mutex_ };
+		auto job{ jobs_.find(id) };
+		Status status;
+
+		if (job == jobs_.end()) {
+			return Status::UNKNOWN;
+		}
+		status = job->second->status;
+		if (status != Status::RUNNING) {
+			output = std::move(job->second->output);
+			jobs_.erase(job);
+		}
+
+		return status;
+	}
+
+
+	size_t Jobs::running() {
+		lock_guard<mutex> guard{ mutex_ };
+		return running_;
+	}
+
+
+	Session::Session() {}
+
+	Session::~Session() {
+		jobs_.reset();
+	}
+
+	Jobs &Session::jobs() {
+		std::lock_guard<std::mutex> guard{ mutex_ };
+
+		if (not jobs_) {
+			jobs_.reset(new Jobs());
+		}
+
+		return *jobs_;
+	}
+
+	bool Session::busy() {
+		std::lock_guard<std::mutex> guard{ mutex_ };
+		return jobs_ and jobs_->running();
+	}
+}
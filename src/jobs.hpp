@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "session.hpp"
+
+namespace commandIO {
+
+	/// \defgroup jobs
+
+	using std::atomic;
+	using std::condition_variable;
+	using std::deque;
+	using std::function;
+	using std::map;
+	using std::mutex;
+	using std::shared_ptr;
+	using std::string;
+	using std::thread;
+	using std::unique_ptr;
+	using std::vector;
+
+	/**
+	 * Fixed number of worker threads with work stealing.
+	 *
+	 * Every worker has its own queue. Tasks submitted by a worker go to its
+	 * own queue and are taken newest first, other tasks are spread over the
+	 * queues. An idle worker steals the oldest task of another queue.
+	 *
+	 * \ingroup jobs
+	 */
+	class ThreadPool {
+	public:
+		/**
+		 * Constructor, turns on locking of instances, see `concurrent()`.
+		 *
+		 * \param size Number of threads, 0 for one per core.
+		 */
+		ThreadPool(size_t = 0);
+
+		/**
+		 * Run all queued tasks and stop the threads.
+		 */
+		~ThreadPool();
+
+		/**
+		 * Queue a task.
+		 *
+		 * \param task Task.
+		 */
+		void submit(function<void()>);
+
+		/**
+		 * Number of worker threads.
+		 *
+		 * \return Number of threads.
+		 */
+		size_t size() const;
+
+		/**
+		 * Number of tasks that wait for a thread.
+		 *
+		 * \return Queue depth.
+		 */
+		size_t queued() const;
+
+		/**
+		 * Pool shared by all sessions, started on first use.
+		 *
+		 * \return Thread pool.
+		 */
+		static ThreadPool &shared();
+
+	private:
+		struct alignas(64) Queue_ {
+			mutex access;
+			deque<function<void()>> tasks;
+		};
+
+		void work_(size_t);
+		bool take_(size_t, function<void()> &);
+
+		vector<unique_ptr<Queue_>> queues_;
+		vector<thread> threads_;
+		atomic<size_t> next_{ 0 }; ///< Queue for the next outside task.
+		atomic<size_t> queued_{ 0 }; ///< Counted before a task is queued.
+		mutex mutex_; ///< Protects `stop_` and sleeping.
+		condition_variable ready_;
+		bool stop_{ false };
+	};
+
+	/**
+	 * Job status.
+	 *
+	 * \ingroup jobs
+	 */
+	enum Status {
+		UNKNOWN, RUNNING, DONE, FAILED
+	};
+
+	char const *const statusNames[]{ "unknown", "running", "done", "failed" };
+
+	/**
+	 * Background jobs of one session.
+	 *
+	 * Every job captures its own output, it is kept until it is collected
+	 * with `result()`.
+	 *
+	 * \ingroup jobs
+	 */
+	class Jobs {
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * \param pool Thread pool.
+		 */
+		Jobs(ThreadPool & = ThreadPool::shared());
+
+		/**
+		 * Wait for all jobs.
+		 */
+		~Jobs();
+
+		/**
+		 * Start a job.
+		 *
+		 * \param command Command line, for listing.
+		 * \param task Task, writes its output to the given string and returns
+		 *   `true` on success.
+		 *
+		 * \return Job id.
+		 */
+		size_t start(string, function<bool(string &)>);
+
+		/**
+		 * List all jobs, one per line.
+		 *
+		 * \return Job list.
+		 */
+		string list();
+
+		/**
+		 * Wait for a job to finish.
+		 *
+		 * \param id Job id.
+		 *
+		 * \return Job status.
+		 */
+		Status wait(size_t);
+
+		/**
+		 * Collect the output of a finished job and forget about the job.
+		 *
+		 * \param id Job id.
+		 * \param output Output of the job.
+		 *
+		 * \return Job status, `output` is only set if the job has finished.
+		 */
+		Status result(size_t, string &);
+
+		/**
+		 * Number of jobs that have not finished.
+		 *
+		 * \return Number of running jobs.
+		 */
+		size_t running();
+
+	private:
+		struct Job_ {
+			string command;
+			string output;
+			Status status{ Status::RUNNING };
+		};
+
+		ThreadPool &pool_;
+		mutex mutex_;
+		condition_variable finished_;
+		map<size_t, shared_ptr<Job_>> jobs_;
+		size_t next_{ 1 };
+		size_t running_{ 0 };
+	};
+}
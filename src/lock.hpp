@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <shared_mutex>
+
+#include "session.hpp"
+
+namespace commandIO {
+
+	/// \defgroup lock
+
+	using std::atomic;
+	using std::shared_mutex;
+
+	// Set once instances may be used by more than one thread.
+	inline atomic<bool> locking_{ false };
+
+	/**
+	 * Lock instances from now on.
+	 *
+	 * Commands skip locking while a single thread runs them. Thread pools,
+	 * and with them background jobs and batches, turn locking on when they
+	 * start. Call this before commands run on threads of your own.
+	 *
+	 * \ingroup lock
+	 */
+	inline void concurrent() {
+		locking_.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Class instance shared by all sessions, used by a command that only
+	 * reads.
+	 *
+	 * \ingroup lock
+	 *
+	 * \tparam C Class.
+	 */
+	template <class C>
+	struct Reader {
+		C *object; ///< Instance.
+		shared_mutex *mutex; ///< Lock of the instance.
+	};
+
+	/**
+	 * Class instance shared by all sessions, used by a command that modifies
+	 * it.
+	 *
+	 * \ingroup lock
+	 *
+	 * \tparam C Class.
+	 */
+	template <class C>
+	struct Writer {
+		C *object; ///< Instance.
+		shared_mutex *mutex; ///< Lock of the instance.
+	};
+
+	/**
+	 * Mark a command as read-only, for example a non-const member function
+	 * that does not modify the instance.
+	 *
+	 * \ingroup lock
+	 *
+	 * \param object Instance.
+	 * \param mutex Lock of the instance.
+	 *
+	 * \return Shared instance.
+	 */
+	template <class C>
+	constexpr Reader<C> reading(C *object, shared_mutex &mutex) {
+		return { object, &mutex };
+	}
+
+	/**
+	 * Mark a command as mutating, for example a const member function that
+	 * modifies `mutable` members.
+	 *
+	 * \ingroup lock
+	 *
+	 * \param object Instance.
+	 * \param mutex Lock of the instance.
+	 *
+	 * \return Shared instance.
+	 */
+	template <class C>
+	constexpr Writer<C> writing(C *object, shared_mutex &mutex) {
+		return { object, &mutex };
+	}
+
+	template <class I, class C>
+	C &object(I &, Reader<C> const &object) {
+		return *object.object;
+	}
+
+	template <class I, class C>
+	C &object(I &, Writer<C> const &object) {
+		return *object.object;
+	}
+
+	/**
+	 * Lock on a shared instance, held while a command runs.
+	 *
+	 * Read-only commands on the same instance run concurrently, mutating
+	 * commands run one at a time.
+	 *
+	 * \ingroup lock
+	 */
+	class Lock {
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * \param mutex Mutex, `nullptr` for no locking.
+		 * \param readOnly Take a shared lock.
+		 */
+		Lock(shared_mutex *mutex, bool readOnly)
+				: mutex_{ mutex }, readOnly_{ readOnly } {
+			if (not mutex_) {
+				return;
+			}
+			if (readOnly_) {
+				mutex_->lock_shared();
+			} else {
+				mutex_->lock();
+			}
+		}
+
+		Lock(Lock const &) = delete;
+
+		~Lock() {
+			if (not mutex_) {
+				return;
+			}
+			if (readOnly_) {
+				mutex_->unlock_shared();
+			} else {
+				mutex_->unlock();
+			}
+		}
+
+	private:
+		shared_mutex *mutex_;
+		bool readOnly_;
+	};
+
+	// Mutex to lock, `nullptr` while locking is off.
+	inline shared_mutex *locked_(shared_mutex *mutex) {
+		if (not locking_.load(std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		return mutex;
+	}
+
+	/**
+	 * Lock an instance for the duration of a command.
+	 *
+	 * Instances given with a mutex are locked by it, plain pointers are not
+	 * locked. Per-session instances are locked as well, background jobs of a
+	 * session use them concurrently with the session itself. Nothing is
+	 * locked before `concurrent()`.
+	 *
+	 * \ingroup lock
+	 *
+	 * \param io Input / output object.
+	 * \param object Instance, shared instance or factory.
+	 * \param readOnly The member function is `const`.
+	 *
+	 * \return Lock.
+	 */
+	template <class I, class C>
+	Lock acquire(I &, C *, bool readOnly) {
+		return { nullptr, readOnly };
+	}
+
+	template <class I, class C>
+	Lock acquire(I &, Shared<C> const &object, bool readOnly) {
+		return { locked_(object.mutex), readOnly };
+	}
+
+	template <class I, class C>
+	Lock acquire(I &, Reader<C> const &object, bool) {
+		return { locked_(object.mutex), true };
+	}
+
+	template <class I, class C>
+	Lock acquire(I &, Writer<C> const &object, bool) {
+		return { locked_(object.mutex), false };
+	}
+
+	template <class I, class C>
+	Lock acquire(I &io, Factory<C> const &factory, bool readOnly) {
+		if (not locking_.load(std::memory_order_relaxed)) {
+			return { nullptr, readOnly };
+		}
+		return { &io.session.mutex(factory.create), readOnly };
+	}
+
+	/**
+	 * Identity of an instance, commands with the same identity use the same
+	 * instance.
+	 *
+	 * \ingroup lock
+	 *
+	 * \param object Instance, shared instance or factory.
+	 *
+	 * \return Identity.
+	 */
+	template <class C>
+	void const *key(C *object) {
+		return object;
+	}
+
+	template <class C>
+	void const *key(Shared<C> const &object) {
+		return object.object;
+	}
+
+	template <class C>
+	void const *key(Reader<C> const &object) {
+		return object.object;
+	}
+
+	template <class C>
+	void const *key(Writer<C> const &object) {
+		return object.object;
+	}
+
+	template <class C>
+	void const *key(Factory<C> const &factory) {
+		return reinterpret_cast<void const *>(factory.create);
+	}
+}
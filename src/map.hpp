@@ -0,0 +1,393 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "args.hpp"
+#include "eval.hpp"
+#include "help.hpp"
+#include "table.hpp"
+#include "tuple.hpp"
+
+namespace commandIO {
+
+	/// \defgroup map
+
+	using std::array;
+	using std::decay_t;
+	using std::index_sequence;
+	using std::index_sequence_for;
+	using std::string_view;
+	using std::vector;
+
+	/*! Function with a batch overload.
+	 *
+	 * \ingroup map
+	 */
+	template <class F, class K>
+	struct Batched {
+		F f; ///< Function pointer.
+		K kernel; ///< Batch overload.
+	};
+
+	/*! Attach a batch overload to a function.
+	 *
+	 * The batch overload takes one column of values per parameter, e.g., a
+	 * `vector<int> const &` or a `span<int const>`, and returns a range with
+	 * one result per argument set or nothing for a function that returns
+	 * `void`. The `map` command prefers it over separate calls of `f`.
+	 *
+	 * \ingroup map
+	 *
+	 * \param f Function pointer.
+	 * \param kernel Batch overload of `f`.
+	 *
+	 * \return Function definition head.
+	 */
+	template <class F, class K>
+	constexpr Batched<F, K> batched(F f, K kernel) {
+		return { f, kernel };
+	}
+
+	/*! Parse user input and call a function that has a batch overload.
+	 *
+	 * \ingroup map
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param io Input / output object.
+	 * \param b Function with a batch overload.
+	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <class H = NoHooks, class I, class F, class K, class D>
+	bool parse(
+			I &io, Batched<F, K> const &b, D &defs, char const *name = "") {
+		return parse<H>(io, b.f, defs, name);
+	}
+
+	/*! Give a full description of a command that has a batch overload.
+	 *
+	 * \ingroup map
+	 *
+	 * \param io Input / output object.
+	 * \param b Function with a batch overload.
+	 * \param name Command name.
+	 * \param descr Command description.
+	 * \param defs Parameter definitions.
+	 */
+	template <class I, class F, class K, class D>
+	void help(
+			I &io, Batched<F, K> const &b, string_view name, string_view descr,
+			D const &defs) {
+		help(io, b.f, name, descr, defs);
+	}
+
+	/*! Tokens from a vector instead of an input / output object.
+	 *
+	 * \ingroup map
+	 */
+	class Tokens {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param tokens Tokens.
+		 */
+		Tokens(vector<string_view> const &tokens) : tokens_{ tokens } {}
+
+		/*!
+		 * Test whether all tokens have been read.
+		 *
+		 * \return `true` if all tokens have been read, `false` otherwise.
+		 */
+		bool eol() const {
+			return index_ == tokens_.size();
+		}
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read() {
+			return tokens_[index_++];
+		}
+
+	private:
+		vector<string_view> const &tokens_;
+		size_t index_{ 0 };
+	};
+
+	/*
+	 * Collect argument sets from `input` and pass each to `add`.
+	 *
+	 * Optional arguments come first and apply to every set, the remaining
+	 * tokens are split into sets of one value per required parameter.
+	 * Defaults and optional arguments are set once and copied for each set.
+	 * A function without required parameters is called once.
+	 */
+	template <class H, class I, class T, class A, class D, class C>
+	bool collect_(I &io, T &input, A &argv, D const &defs, C add) {
+		A values;
+		int number{ 0 };
+		bool options{ true };
+
+		setDefault(argv, defs);
+
+		int opt;
+		int req;
+		countArgs(req, opt, defs);
+
+		while (not input.eol()) {
+			Error errorCode;
+			string_view token{ input.read() };
+
+			H::onToken(token);
+
+			if (options and not token.empty() and token[0] == '-') {
+				errorCode = updateOptional(input, argv, defs, token);
+
+				switch (errorCode) {
+					case Error::SUCCESS:
+						continue;
+					case Error::UNKNOWN_PARAM:
+						break;
+					default:
+						H::onError(errorCode);
+						Stats::error(errorCode);
+						print(io, errorMessages[errorCode], token, "\n");
+						return false;
+				}
+			}
+			options = false;
+
+			if (not number) {
+				values = argv;
+			}
+			errorCode = updateRequired(values, defs, number, token);
+
+			if (errorCode != Error::SUCCESS) {
+				H::onError(errorCode);
+				Stats::error(errorCode);
+				print(io, errorMessages[errorCode], number + 1, "\n");
+				return false;
+			}
+			if (++number == req) {
+				add(values);
+				number = 0;
+			}
+		}
+
+		if (number) {
+			H::onError(Error::MISSING_PARAM);
+			Stats::error(Error::MISSING_PARAM);
+			print(io, errorMessages[Error::MISSING_PARAM], "\n");
+			return false;
+		}
+		if (not req) {
+			values = argv;
+			add(values);
+		}
+
+		return true;
+	}
+
+	// Call a function or class member function for every argument set.
+	template <class H, class I, class T, class F, class A, class D>
+	bool map_(I &io, T &input, F f, A &argv, D &defs, char const *name) {
+		vector<A> sets;
+
+		if (not collect_<H>(io, input, argv, defs, [&](A &values) {
+					sets.push_back(std::move(values));
+				})) {
+			return false;
+		}
+		for (A const &values: sets) {
+			if (not H::beforeCall(name, values)) {
+				return false;
+			}
+		}
+		for (A &values: sets) {
+			uint64_t begin{ H::timed ? ticks() : 0 };
+			call(io, f, values, [name, begin](auto const &result) {
+				H::afterCall(name, result, H::timed ? ticks() - begin : 0);
+			});
+		}
+
+		return true;
+	}
+
+	// Add the values of one argument set to the columns.
+	inline void append_(Empty, Empty) {}
+
+	template <class C, class A>
+	void append_(C &columns, A &values) {
+		columns.head.push_back(std::move(values.head));
+		append_(columns.tail, values.tail);
+	}
+
+	// Call a batch overload with all columns.
+	template <class K, class... Columns>
+	decltype(auto) kernel_(K kernel, Empty, Columns &...columns) {
+		return kernel(columns...);
+	}
+
+	template <class K, class C, class... Columns>
+	decltype(auto) kernel_(K kernel, C &rest, Columns &...columns) {
+		return kernel_(kernel, rest.tail, columns..., rest.head);
+	}
+
+	/*! Parse user input and call a function once per argument set.
+	 *
+	 * \ingroup map
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param io Input / output object.
+	 * \param input Token source, usually `io`.
+	 * \param f Function pointer or Tuple for class member functions.
+	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <
+			class H = NoHooks, class I, class T, class O, class R, class P,
+			class... FArgs, class D>
+	bool parseMap(
+			I &io, T &input, RetM<O, R, P, FArgs...> m, D &defs,
+			char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return map_<H>(io, input, m, argv, defs, name);
+	}
+
+	template <
+			class H = NoHooks, class I, class T, class O, class R, class P,
+			class... FArgs, class D>
+	bool parseMap(
+			I &io, T &input, RetC<O, R, P, FArgs...> m, D &defs,
+			char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return map_<H>(io, input, m, argv, defs, name);
+	}
+
+	template <
+			class H = NoHooks, class I, class T, class R, class... FArgs, class D>
+	bool parseMap(
+			I &io, T &input, RetF<R, FArgs...> f, D &defs, char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		return map_<H>(io, input, f, argv, defs, name);
+	}
+
+	/*! Parse user input and call the batch overload of a function once.
+	 *
+	 * \ingroup map
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param io Input / output object.
+	 * \param input Token source, usually `io`.
+	 * \param b Function with a batch overload.
+	 * \param defs Parameter definitions.
+	 * \param name Command name, for the hooks.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <
+			class H = NoHooks, class I, class T, class R, class... FArgs, class K,
+			class D>
+	bool parseMap(
+			I &io, T &input, Batched<R (*)(FArgs...), K> const &b, D &defs,
+			char const *name = "") {
+		Tuple<decay_t<FArgs>...> argv;
+		Tuple<vector<decay_t<FArgs>>...> columns;
+		bool accepted{ true };
+
+		if (
+				not collect_<H>(
+						io, input, argv, defs,
+						[&](auto &values) {
+							if (not H::beforeCall(name, std::as_const(values))) {
+								accepted = false;
+							}
+							append_(columns, values);
+						}) or
+				not accepted) {
+			return false;
+		}
+
+		// The hooks see one call with all results.
+		uint64_t begin{ H::timed ? ticks() : 0 };
+		if constexpr (std::is_void_v<decltype(kernel_(b.kernel, columns))>) {
+			kernel_(b.kernel, columns);
+			H::afterCall(name, Void{}, H::timed ? ticks() - begin : 0);
+		} else {
+			decltype(auto) results = kernel_(b.kernel, columns);
+			for (auto const &result: results) {
+				print(io, result, "\n");
+			}
+			H::afterCall(name, results, H::timed ? ticks() - begin : 0);
+		}
+
+		return true;
+	}
+
+	// Map function definition `N`.
+	template <class H, class I, class T, class D, size_t N>
+	bool mapAt_(I &io, T &input, D const &defs) {
+		auto const &def{ get<N>(defs) };
+
+		Stats::begin(def.tail.head);
+		bool success{ parseMap<H>(
+				io, input, def.head, def.tail.tail.tail, def.tail.head) };
+		Stats::end(success);
+
+		return success;
+	}
+
+	// Jump table of `mapAt_()` instances.
+	template <class H, class I, class T, class D, size_t... Is>
+	bool selectMap_(
+			I &io, T &input, size_t index, D const &defs, index_sequence<Is...>) {
+		static constexpr array<bool (*)(I &, T &, D const &), sizeof...(Is)>
+				thunks{ mapAt_<H, I, T, D, Is>... };
+		return thunks[index](io, input, defs);
+	}
+
+	/*! Select a function for mapping.
+	 *
+	 * The command is looked up once for all argument sets.
+	 *
+	 * \ingroup map
+	 *
+	 * \tparam H Hook policy.
+	 *
+	 * \param io Input / output object.
+	 * \param input Token source, usually `io`.
+	 * \param name Command name.
+	 * \param defs Function definitions.
+	 * \param table Command table of `defs`.
+	 *
+	 * \return `true` on success, `false` otherwise.
+	 */
+	template <class H = NoHooks, class I, class T, class... Defs, size_t N>
+	bool selectMap(
+			I &io, T &input, string_view name, Tuple<Defs...> const &defs,
+			Table<N> const &table) {
+		size_t index{ table.find(name.data(), name.size()) };
+
+		if (index == N) {
+			unknown_<H>(io, name);
+			return false;
+		}
+
+		return selectMap_<H>(
+				io, input, index, defs, index_sequence_for<Defs...>{});
+	}
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "metrics.hpp"
+
+namespace commandIO {
+
+	namespace {
+		size_t const words_{ sizeof(Metrics) / sizeof(uint64_t) };
+
+		// Give up when the writer keeps the segment busy, e.g., it died.
+		size_t const retries_{ 1000 };
+	}
+
+	string metricsName() {
+		return "/commandIO-" + std::to_string(getpid());
+	}
+
+	MetricsPublisher::~MetricsPublisher() {
+		close();
+	}
+
+	bool MetricsPublisher::open(
+			string const &name, std::chrono::milliseconds interval,
+			ThreadPool *pool) {
+		if (segment_) {
+			return false;
+		}
+
+		int fd{ shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644) };
+		if (fd < 0) {
+			return false;
+		}
+		if (ftruncate(fd, sizeof(MetricsSegment))) {
+			::close(fd);
+			shm_unlink(name.c_str());
+			return false;
+		}
+
+		void *data{ mmap(
+				nullptr, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED,
+				fd, 0) };
+		::close(fd);
+		if (data == MAP_FAILED) {
+			shm_unlink(name.c_str());
+			return false;
+		}
+
+		// The file is zero filled, a sequence of 0 means not published yet.
+		segment_ = new (data) MetricsSegment;
+		segment_->magic = metricsMagic;
+		segment_->version = metricsVersion;
+		segment_->size = sizeof(Metrics);
+		name_ = name;
+		interval_ = interval;
+		pool_ = pool;
+		stop_ = false;
+
+		publish();
+		thread_ = thread(&MetricsPublisher::run_, this);
+
+		return true;
+	}
+
+	void MetricsPublisher::publish() {
+		std::lock_guard<mutex> lock{ access_ };
+
+		if (not segment_) {
+			return;
+		}
+
+		Snapshot snapshot{ Stats::snapshot() };
+		double scale{ tickNanoseconds() };
+		Metrics &metrics{ metrics_ };
+		size_t slot{ 0 };
+
+		metrics.pid = uint64_t(getpid());
+		metrics.updated =
+				uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+										 std::chrono::system_clock::now().time_since_epoch())
+										 .count());
+		metrics.updates++;
+		metrics.dispatched = 0;
+		metrics.errors = 0;
+		metrics.bytesRead = snapshot.io.bytesRead;
+		metrics.bytesWritten = snapshot.io.bytesWritten;
+		metrics.writes = snapshot.io.writes;
+		metrics.tokens = snapshot.io.tokens;
+		metrics.queued = pool_ ? pool_->queued() : 0;
+		metrics.workers = pool_ ? pool_->size() : 0;
+
+		for (auto const &[name, totals]: snapshot.commands) {
+			uint64_t errors{ 0 };
+			for (uint64_t count: totals.errors) {
+				errors += count;
+			}
+			metrics.dispatched += totals.calls;
+			metrics.errors += errors;
+
+			if (slot == metricsCommands) {
+				continue;
+			}
+
+			MetricsCommand &command{ metrics.commands[slot++] };
+			memset(command.name, 0, metricsNameSize);
+			name.copy(command.name, metricsNameSize - 1);
+			command.calls = totals.calls;
+			std::copy(totals.errors, totals.errors + errorKinds, command.errors);
+			command.time = uint64_t(totals.time * scale);
+			command.p50 = uint64_t(totals.percentile(0.5) * scale);
+			command.p90 = uint64_t(totals.percentile(0.9) * scale);
+			command.p99 = uint64_t(totals.percentile(0.99) * scale);
+			command.max = uint64_t(totals.max * scale);
+		}
+		metrics.size = slot;
+		metrics.dropped = snapshot.commands.size() - slot;
+		memset(
+				metrics.commands + slot, 0,
+				(metricsCommands - slot) * sizeof(MetricsCommand));
+
+		uint64_t words[words_];
+		uint64_t sequence{ segment_->sequence.load(std::memory_order_relaxed) };
+
+		memcpy(words, &metrics, sizeof(Metrics));
+		// A reader that sees any new word also sees the odd sequence.
+		segment_->sequence.store(sequence + 1, std::memory_order_relaxed);
+		for (size_t i{ 0 }; i < words_; i++) {
+			segment_->words[i].store(words[i], std::memory_order_release);
+		}
+		segment_->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void MetricsPublisher::close() {
+		if (thread_.joinable()) {
+			{
+				std::lock_guard<mutex> lock{ mutex_ };
+				stop_ = true;
+			}
+			wake_.notify_all();
+			thread_.join();
+		}
+
+		std::lock_guard<mutex> lock{ access_ };
+		if (segment_) {
+			munmap(segment_, sizeof(MetricsSegment));
+			shm_unlink(name_.c_str());
+			segment_ = nullptr;
+		}
+	}
+
+	void MetricsPublisher::run_() {
+		std::unique_lock<mutex> lock{ mutex_ };
+
+		while (not wake_.wait_for(lock, interval_, [this]() { return stop_; })) {
+			lock.unlock();
+			publish();
+			lock.lock();
+		}
+	}
+
+	MetricsReader::~MetricsReader() {
+		if (segment_) {
+			munmap(const_cast<MetricsSegment *>(segment_), sizeof(MetricsSegment));
+		}
+	}
+
+	bool MetricsReader::open(string const &name) {
+		struct stat status;
+
+		if (segment_) {
+			return false;
+		}
+
+		int fd{ shm_open(name.c_str(), O_RDONLY, 0) };
+		if (fd < 0) {
+			return false;
+		}
+		if (
+				fstat(fd, &status) or
+				size_t(status.st_size) < sizeof(MetricsSegment)) {
+			::close(fd);
+			return false;
+		}
+
+		void *data{
+			mmap(nullptr, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, fd, 0) };
+		::close(fd);
+		if (data == MAP_FAILED) {
+			return false;
+		}
+		segment_ = static_cast<MetricsSegment const *>(data);
+
+		return true;
+	}
+
+	bool MetricsReader::read(Metrics &metrics) const {
+		uint64_t words[words_];
+
+		if (not segment_) {
+			return false;
+		}
+
+		for (size_t attempt{ 0 }; attempt < retries_; attempt++) {
+			uint64_t before{ segment_->sequence.load(std::memory_order_acquire) };
+
+			if (not before) {
+				return false;
+			}
+			if (
+					segment_->magic != metricsMagic or
+					segment_->version != metricsVersion or
+					segment_->size != sizeof(Metrics)) {
+				return false;
+			}
+			if (before & 1) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			for (size_t i{ 0 }; i < words_; i++) {
+				words[i] = segment_->words[i].load(std::memory_order_acquire);
+			}
+			if (segment_->sequence.load(std::memory_order_relaxed) == before) {
+				memcpy(&metrics, words, sizeof(Metrics));
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "jobs.hpp"
+#include "stats.hpp"
+
+namespace commandIO {
+
+	/// \defgroup metrics
+
+	using std::atomic;
+	using std::condition_variable;
+	using std::mutex;
+	using std::string;
+	using std::thread;
+	using std::uint32_t;
+	using std::uint64_t;
+
+	uint64_t const metricsMagic{ 0x72746d4f49646d63 }; ///< Identifies a segment.
+	uint32_t const metricsVersion{ 2 }; ///< Changed with every layout change.
+	size_t const metricsCommands{ 64 }; ///< Command slots.
+	size_t const metricsNameSize{ 48 };
+
+	// A new error kind changes the layout.
+	static_assert(errorKinds == 11, "bump metricsVersion");
+
+	/*!
+	 * Published counters of one command.
+	 *
+	 * \ingroup metrics
+	 */
+	struct MetricsCommand {
+		char name[metricsNameSize]; ///< Zero terminated, long names are cut.
+		uint64_t calls;
+		uint64_t errors[errorKinds]; ///< Failed calls per error code.
+		uint64_t time; ///< Nanoseconds.
+		uint64_t p50; ///< Nanoseconds.
+		uint64_t p90; ///< Nanoseconds.
+		uint64_t p99; ///< Nanoseconds.
+		uint64_t max; ///< Nanoseconds.
+	};
+
+	/*!
+	 * Published counters of a process, version `metricsVersion`.
+	 *
+	 * \ingroup metrics
+	 */
+	struct Metrics {
+		uint64_t pid;
+		uint64_t updated; ///< Nanoseconds since the epoch.
+		uint64_t updates; ///< Number of updates so far.
+		uint64_t dispatched; ///< Commands run.
+		uint64_t errors; ///< Commands that failed.
+		uint64_t bytesRead;
+		uint64_t bytesWritten;
+		uint64_t writes;
+		uint64_t tokens;
+		uint64_t queued; ///< Tasks waiting for a thread of the pool.
+		uint64_t workers; ///< Threads of the pool.
+		uint64_t size; ///< Used command slots.
+		uint64_t dropped; ///< Commands that did not fit in a slot.
+		MetricsCommand commands[metricsCommands];
+	};
+
+	/*!
+	 * Shared memory segment.
+	 *
+	 * The metrics are stored as atomic words under a sequence lock: the
+	 * sequence is odd while an update is written, a reader retries when it
+	 * changed during the read. Neither side takes a lock.
+	 * The header is written before the first update.
+	 *
+	 * \ingroup metrics
+	 */
+	struct MetricsSegment {
+		uint64_t magic;
+		uint32_t version;
+		uint32_t size; ///< Size of `Metrics`.
+		atomic<uint64_t> sequence; ///< 0 until the first update.
+		atomic<uint64_t> words[sizeof(Metrics) / sizeof(uint64_t)];
+	};
+
+	static_assert(sizeof(Metrics) % sizeof(uint64_t) == 0);
+	static_assert(atomic<uint64_t>::is_always_lock_free);
+
+	/*!
+	 * Default segment name of the current process.
+	 *
+	 * \ingroup metrics
+	 *
+	 * \return Segment name, `/commandIO-<pid>`.
+	 */
+	string metricsName();
+
+	/**
+	 * Publish the statistics collected by `Stats` to shared memory.
+	 *
+	 * A thread takes a snapshot at a fixed interval, commands never wait for
+	 * it. The segment is removed when the publisher is closed.
+	 *
+	 * \ingroup metrics
+	 */
+	class MetricsPublisher {
+	public:
+		MetricsPublisher() = default;
+		MetricsPublisher(MetricsPublisher const &) = delete;
+		MetricsPublisher &operator=(MetricsPublisher const &) = delete;
+
+		~MetricsPublisher();
+
+		/*!
+		 * Create a segment and start publishing.
+		 *
+		 * \param name Segment name, see `shm_open()`.
+		 * \param interval Time between updates.
+		 * \param pool Thread pool whose queue depth is published, if any.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		bool open(
+				string const &,
+				std::chrono::milliseconds = std::chrono::milliseconds(100),
+				ThreadPool * = nullptr);
+
+		/*!
+		 * Update the segment now, e.g., before the process ends.
+		 */
+		void publish();
+
+		/*!
+		 * Stop publishing and remove the segment.
+		 */
+		void close();
+
+	private:
+		void run_();
+
+		MetricsSegment *segment_{ nullptr };
+		string name_;
+		std::chrono::milliseconds interval_;
+		ThreadPool *pool_{ nullptr };
+		Metrics metrics_{}; ///< Written under `access_`.
+		mutex access_;
+		thread thread_;
+		mutex mutex_; ///< Protects `stop_`.
+		condition_variable wake_;
+		bool stop_{ false };
+	};
+
+	/**
+	 * Read metrics that another process publishes.
+	 *
+	 * \ingroup metrics
+	 */
+	class MetricsReader {
+	public:
+		MetricsReader() = default;
+		MetricsReader(MetricsReader const &) = delete;
+		MetricsReader &operator=(MetricsReader const &) = delete;
+
+		~MetricsReader();
+
+		/*!
+		 * Map a segment.
+		 *
+		 * \param name Segment name.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		bool open(string const &);
+
+		/*!
+		 * Read a consistent copy of the metrics.
+		 *
+		 * \param[out] metrics Metrics.
+		 *
+		 * \return `true` on success, `false` if nothing was published yet, the
+		 *   layout version differs or no consistent copy could be read.
+		 */
+		bool read(Metrics &) const;
+
+	private:
+		MetricsSegment const *segment_{ nullptr };
+	};
+}
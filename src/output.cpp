@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "output.hpp"
+#include "stats.hpp"
+
+namespace commandIO {
+
+	FileRegion fileRegion(char const *path) {
+		int fd{ open(path, O_RDONLY | O_CLOEXEC) };
+		struct stat status {};
+
+		if (fd != -1 and fstat(fd, &status) == -1) {
+			close(fd);
+			fd = -1;
+		}
+
+		return { fd, 0, size_t(status.st_size), true };
+	}
+
+	OutputBuffer::OutputBuffer(int fd, size_t threshold)
+			: policy{ isatty(fd) ? Flush::COMMAND : Flush::FULL },
+				threshold{ threshold }, fd_{ fd } {
+		data_.reserve(threshold);
+	}
+
+	OutputBuffer::~OutputBuffer() {
+		flush();
+	}
+
+	void OutputBuffer::write(char const *data, size_t size) {
+		if (data_.size() + size <= threshold) {
+			data_.append(data, size);
+			return;
+		}
+		send_(data, size);
+	}
+
+	void OutputBuffer::write(FileRegion const &region) {
+		off_t offset{ region.offset };
+		size_t size{ region.size };
+
+		flush();
+
+		while (size and region.fd != -1) {
+			ssize_t written{ sendfile(fd_, region.fd, &offset, size) };
+
+			if (written > 0) {
+				Stats::write(written);
+				size -= written;
+			} else if (not written) {
+				break;
+			} else if (errno == EAGAIN or errno == EWOULDBLOCK) {
+				pollfd event{ fd_, POLLOUT, 0 };
+				poll(&event, 1, -1);
+			} else if (errno == EINVAL or errno == ENOSYS) {
+				// No `sendfile()` support for this pair of file descriptors.
+				char chunk[65536];
+				ssize_t read{ pread(
+						region.fd, chunk, std::min(size, sizeof(chunk)), offset) };
+
+				if (read <= 0) {
+					break;
+				}
+				send_(chunk, read);
+				offset += read;
+				size -= read;
+			} else if (errno != EINTR) {
+				break;
+			}
+		}
+
+		if (region.owned and region.fd != -1) {
+			close(region.fd);
+		}
+	}
+
+	void OutputBuffer::flush() {
+		send_(nullptr, 0);
+	}
+
+	void OutputBuffer::endCommand() {
+		if (policy == Flush::COMMAND) {
+			flush();
+		}
+	}
+
+	/*
+	 * Write the buffer followed by `data` with as few system calls as
+	 * possible.
+	 */
+	void OutputBuffer::send_(char const *data, size_t size) {
+		iovec parts[]{
+			{ data_.data(), data_.size() }, { const_cast<char *>(data), size } };
+		iovec *part{ parts };
+		int count{ size ? 2 : 1 };
+
+		while (count) {
+			if (not part->iov_len) {
+				part++;
+				count--;
+				continue;
+			}
+
+			ssize_t written{ writev(fd_, part, count) };
+
+			if (written < 0) {
+				if (errno == EAGAIN or errno == EWOULDBLOCK) {
+					pollfd event{ fd_, POLLOUT, 0 };
+					poll(&event, 1, -1);
+				} else if (errno != EINTR) {
+					break;
+				}
+				continue;
+			}
+			Stats::write(written);
+
+			while (count and size_t(written) >= part->iov_len) {
+				written -= part->iov_len;
+				part++;
+				count--;
+			}
+			if (count) {
+				part->iov_base = static_cast<char *>(part->iov_base) + written;
+				part->iov_len -= written;
+			}
+		}
+
+		data_.clear();
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+namespace commandIO {
+
+	using std::size_t;
+	using std::string;
+
+	/*!
+	 * Output flush policies.
+	 */
+	enum Flush {
+		COMMAND, ///< After every command and before waiting for input.
+		FULL ///< When the buffer is full and before waiting for input.
+	};
+
+	/*!
+	 * Region of a file, written to the output without copying it into memory.
+	 */
+	struct FileRegion {
+		int fd; ///< File descriptor.
+		off_t offset; ///< Start of the region.
+		size_t size; ///< Size of the region.
+		bool owned{ false }; ///< Close `fd` once the region has been written.
+	};
+
+	/*!
+	 * Region that covers a whole file.
+	 *
+	 * \param path Path to the file.
+	 *
+	 * \return Region that owns its file descriptor, `fd` is -1 if the file
+	 *   could not be opened.
+	 */
+	FileRegion fileRegion(char const *);
+
+	/*!
+	 * Container formatting.
+	 */
+	struct Format {
+		char const *separator{ " " }; ///< Between elements.
+		char const *open{ "" }; ///< Before the first element.
+		char const *close{ "" }; ///< After the last element.
+	};
+
+	/*!
+	 * Buffered output.
+	 *
+	 * Output is collected and written to a file descriptor with as few system
+	 * calls as possible.
+	 */
+	class OutputBuffer {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * The flush policy defaults to `COMMAND` for terminals and to `FULL`
+		 * otherwise.
+		 *
+		 * \param fd File descriptor.
+		 * \param threshold Buffer size that triggers a flush.
+		 */
+		OutputBuffer(int fd, size_t threshold = 65536);
+
+		~OutputBuffer();
+
+		/*!
+		 * Append data, data that does not fit is written directly.
+		 *
+		 * \param data Data.
+		 * \param size Size of `data`.
+		 */
+		void write(char const *, size_t);
+
+		/*!
+		 * Write a region of a file with `sendfile()`, falling back to reading
+		 * and writing when that is not supported.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Write all buffered data.
+		 */
+		void flush();
+
+		/*!
+		 * Mark the end of a command's output.
+		 */
+		void endCommand();
+
+		Flush policy;
+		size_t threshold;
+
+	private:
+		void send_(char const *, size_t);
+
+		int fd_;
+		string data_;
+	};
+}
@@ -1,24 +1,58 @@
-#include <iostream>
-
+#include "../../reactor.hpp"
+#include "../../stats.hpp"
 #include "io.hpp"
 
 namespace commandIO {
-	using std::cout;
 
 	CliIO::CliIO(int argc, char** argv) {
 	  argc_ = argc;
 	  argv_ = argv;
 	}
 
+	size_t CliIO::available() const {
+	  return eol() ? 0 : argc_ - 1 - number_;
+	}
+
+	bool CliIO::wait() const {
+	  Reactor &reactor{ Reactor::local() };
+
+	  while (tasks and reactor.pending()) {
+	    reactor.run();
+	  }
+	  return false;
+	}
+
 	bool CliIO::eol() const {
 	  return number_ >= argc_ - 1;
 	}
 
-	string CliIO::read() {
+	void CliIO::flush() {
+	  number_ = argc_ - 1;
+	}
+
+	string_view CliIO::read() {
+	  Stats::token();
 	  return argv_[++number_];
 	}
 
-	void CliIO::write(string const& data) const {
-	  cout << data;
+	string_view CliIO::back() const {
+	  return argc_ > 1 ? argv_[argc_ - 1] : string_view{};
+	}
+
+	void CliIO::write(char const* data, size_t size) {
+	  output.write(data, size);
+	}
+
+	void CliIO::write(string const& data) {
+	  output.write(data.data(), data.size());
+	}
+
+	void CliIO::write(FileRegion const& region) {
+	  output.write(region);
+	}
+
+	void CliIO::endCommand(bool) {
+	  flush();
+	  output.endCommand();
 	}
 }
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstdio>
 #include <string>
+#include <string_view>
+
+#include "../../builtins.hpp"
+#include "../../output.hpp"
+#include "../../session.hpp"
 
 namespace commandIO {
 
 	using std::string;
+	using std::string_view;
 
 	/*!
 	 * User input and output.
@@ -15,6 +22,21 @@ namespace commandIO {
 
 		CliIO(int, char **);
 
+		/*!
+		 * Number of unread arguments.
+		 *
+		 * \return Number of arguments left.
+		 */
+		size_t available() const;
+
+		/*!
+		 * Wait for input, there is none beyond the command line. Task commands
+		 * in flight are completed first.
+		 *
+		 * \return `false`.
+		 */
+		bool wait() const;
+
 		/*!
 		 * Check whether a line ending was encountered.
 		 *
@@ -22,27 +44,66 @@ namespace commandIO {
 		 */
 		bool eol() const;
 
-		void flush(){};
+		/*!
+		 * Skip the rest of the command line.
+		 */
+		void flush();
 
 		/*!
 		 * Read one string.
 		 *
 		 * \return String.
 		 */
-		string read();
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Write data.
+		 *
+		 * \param[in] data Data.
+		 * \param[in] size Size of `data`.
+		 */
+		void write(char const *, size_t);
 
 		/*!
 		 * Write one string.
 		 *
 		 * \param[in] data String.
 		 */
-		void write(string const &) const;
+		void write(string const &);
+
+		/*!
+		 * Write a region of a file.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Mark the end of a command's output. The command line holds a single
+		 * command, arguments it did not read are skipped.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		void endCommand(bool);
 
 		bool interactive{ false };
+		/// A single command runs, statistics and jobs would not outlive it.
+		static constexpr unsigned builtins{ Builtin::MAP | Builtin::PROFILE };
+		OutputBuffer output{ fileno(stdout) };
+		Format format;
+		Session session;
+		size_t tasks{ 0 }; ///< Task commands in flight.
 
 	private:
-		int argc_;
-		char **argv_;
+		int argc_{ 0 };
+		char **argv_{ nullptr };
 		int number_{ 0 };
 	};
 }
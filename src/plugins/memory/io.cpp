@@ -0,0 +1,91 @@
+#include <cerrno>
+#include <unistd.h>
+
+#include "../../reactor.hpp"
+#include "../../stats.hpp"
+#include "io.hpp"
+
+namespace commandIO {
+
+	MemoryIO::MemoryIO(vector<vector<string>> lines)
+			: session{ own_ }, lines_{ std::move(lines) } {}
+
+	MemoryIO::MemoryIO(vector<string> tokens, Session &session)
+			: session{ session }, lines_{ std::move(tokens) }, started_{ true } {}
+
+	size_t MemoryIO::available() {
+		if (started_ and line_ < lines_.size()) {
+			line_++;
+		}
+		started_ = true;
+		token_ = 0;
+
+		return line_ < lines_.size() ? lines_[line_].size() : 0;
+	}
+
+	bool MemoryIO::wait() const {
+		Reactor &reactor{ Reactor::local() };
+
+		while (tasks and reactor.pending()) {
+			reactor.run();
+		}
+
+		return false;
+	}
+
+	bool MemoryIO::eol() const {
+		return line_ == lines_.size() or token_ == lines_[line_].size();
+	}
+
+	void MemoryIO::flush() {
+		if (line_ < lines_.size()) {
+			token_ = lines_[line_].size();
+		}
+	}
+
+	string_view MemoryIO::read() {
+		Stats::token();
+		return lines_[line_][token_++];
+	}
+
+	string_view MemoryIO::back() const {
+		return lines_[line_].size() ? lines_[line_].back() : string_view{};
+	}
+
+	void MemoryIO::write(char const *data, size_t size) {
+		output.append(data, size);
+	}
+
+	void MemoryIO::write(string const &data) {
+		output.append(data);
+	}
+
+	void MemoryIO::write(FileRegion const &region) {
+		off_t offset{ region.offset };
+		size_t size{ region.size };
+
+		while (size and region.fd != -1) {
+			size_t end{ output.size() };
+
+			output.resize(end + size);
+			ssize_t read{ pread(region.fd, &output[end], size, offset) };
+
+			if (read <= 0) {
+				output.resize(end);
+				if (read == -1 and errno == EINTR) {
+					continue;
+				}
+				break;
+			}
+			output.resize(end + read);
+			offset += read;
+			size -= read;
+		}
+
+		if (region.owned and region.fd != -1) {
+			close(region.fd);
+		}
+	}
+
+	void MemoryIO::endCommand(bool) {}
+}
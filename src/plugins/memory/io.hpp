@@ -0,0 +1,124 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../builtins.hpp"
+#include "../../output.hpp"
+#include "../../session.hpp"
+
+namespace commandIO {
+
+	using std::string;
+	using std::string_view;
+	using std::vector;
+
+	/**
+	 * Input from memory and output to memory.
+	 *
+	 * Every line is a list of tokens. All output is collected in `output`.
+	 */
+	class MemoryIO {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param lines Lines of tokens.
+		 */
+		MemoryIO(vector<vector<string>> = {});
+
+		/*!
+		 * Constructor for a single line that uses the objects of another
+		 * session.
+		 *
+		 * \param tokens Tokens.
+		 * \param session Session.
+		 */
+		MemoryIO(vector<string>, Session &);
+
+		/*!
+		 * Move to the next line.
+		 *
+		 * \return Number of tokens in the line, 0 if there are no more lines.
+		 */
+		size_t available();
+
+		/*!
+		 * Wait for input, there is none beyond the given lines. Task commands
+		 * in flight are completed first.
+		 *
+		 * \return `false`.
+		 */
+		bool wait() const;
+
+		/*!
+		 * Check whether a line ending was encountered.
+		 *
+		 * \return `true` if a line ending was encountered, `false` otherwise.
+		 */
+		bool eol() const;
+
+		/**
+		 * Flush the input.
+		 */
+		void flush();
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Write data.
+		 *
+		 * \param data Data.
+		 * \param size Size of `data`.
+		 */
+		void write(char const *, size_t);
+
+		/*!
+		 * Write one string.
+		 *
+		 * \param data String.
+		 */
+		void write(string const &);
+
+		/*!
+		 * Write a region of a file.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Mark the end of a command's output.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		void endCommand(bool);
+
+		bool interactive{ false };
+		unsigned builtins{ Builtin::BUILTINS }; ///< See `Builtin`.
+		string output;
+		Format format;
+		Session &session;
+		size_t tasks{ 0 }; ///< Task commands in flight.
+
+	private:
+		vector<vector<string>> lines_;
+		size_t line_{ 0 };
+		size_t token_{ 0 };
+		bool started_{ false };
+		Session own_;
+	};
+}
@@ -1,95 +1,94 @@
+#include <cerrno>
 #include <fcntl.h>
-#include <iostream>
+#include <poll.h>
 
+#include "../../error.hpp"
+#include "../../reactor.hpp"
 #include "io.hpp"
 
 namespace commandIO {
 
-	using std::cout;
+	using std::to_string;
 
-	ReplIO::ReplIO() {
-		int fd{ fileno(stdin) };
-		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	ReplIO::ReplIO(size_t maxLine) : input_(maxLine) {
+		flags_ = fcntl(fd_, F_GETFL);
+		fcntl(fd_, F_SETFL, flags_ | O_NONBLOCK);
 	}
 
 	ReplIO::~ReplIO() {
-		delete[] data_;
+		fcntl(fd_, F_SETFL, flags_);
 	}
 
 	size_t ReplIO::available() {
-		int c{ getc(stdin) };
+		size_t size{ input_.next() };
 
-		if (c != -1) {
-			if (escape_) {
-				store_(c);
-				escape_ = false;
-				return 0;
-			}
+		if (not size and not closed_) {
+			closed_ = not input_.receive(fd_);
+			size = input_.next();
+		}
 
-			switch (c) {
-				case '\\':
-					escape_ = true;
-					break;
-				case '"':
-					quoted_ = not quoted_;
-					break;
-				case ' ':
-				case '\t':
-					if (not quoted_) {
-						store_('\0');
-					} else {
-						store_(c);
-					}
-					break;
-				case '\n':
-					store_('\0');
-					escape_ = false;
-					quoted_ = false;
-
-					return index_;
-				default:
-					store_(c);
+		if (input_.overflow()) {
+			write(
+					errorMessages[Error::LINE_TOO_LONG] + to_string(input_.maxLine) +
+					"\n");
+		}
+
+		return size;
+	}
+
+	bool ReplIO::wait() {
+		Reactor &reactor{ Reactor::local() };
+
+		if (closed_) {
+			// Let task commands in flight complete.
+			while (tasks and reactor.pending()) {
+				output.flush();
+				reactor.run();
 			}
+			return false;
 		}
 
-		return 0;
+		output.flush();
+
+		pollfd events[]{ { fd_, POLLIN, 0 }, { -1, POLLIN, 0 } };
+		if (reactor.pending()) {
+			events[1].fd = reactor.fd();
+		}
+		while (poll(events, 2, -1) == -1 and errno == EINTR) {}
+		reactor.run(0);
+
+		return true;
 	}
 
 	bool ReplIO::eol() const {
-		return not(index_ or offset_);
+		return input_.eol();
 	}
 
 	void ReplIO::flush() {
-		while (not eol()) {
-			read();
-		}
+		input_.flush();
 	}
 
-	char *ReplIO::read() {
-		size_t offset{ offset_ };
+	string_view ReplIO::read() {
+		return input_.read();
+	}
 
-		while (offset_ < index_ - 1) {
-			if (not data_[offset_]) {
-				offset_++;
-				return &data_[offset];
-			}
-			offset_++;
-		}
+	string_view ReplIO::back() const {
+		return input_.back();
+	}
 
-		index_ = 0;
-		offset_ = 0;
+	void ReplIO::write(char const *data, size_t size) {
+		output.write(data, size);
+	}
 
-		return &data_[offset];
+	void ReplIO::write(string const &data) {
+		output.write(data.data(), data.size());
 	}
 
-	void ReplIO::write(string const &data) const {
-		cout << data;
+	void ReplIO::write(FileRegion const &region) {
+		output.write(region);
 	}
 
-	void ReplIO::store_(int c) {
-		if (c or (index_ and data_[index_ - 1])) {
-			data_[index_] = (char)c;
-			index_++;
-		}
+	void ReplIO::endCommand(bool) {
+		output.endCommand();
 	}
 }
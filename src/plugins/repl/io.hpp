@@ -1,22 +1,47 @@
 #pragma once
 
+#include <cstdio>
 #include <string>
+#include <string_view>
+
+#include "../../input.hpp"
+#include "../../output.hpp"
+#include "../../session.hpp"
 
 namespace commandIO {
 
 	using std::string;
+	using std::string_view;
 
 	/**
 	 * User input and output.
 	 */
 	class ReplIO {
 	public:
-		ReplIO();
+		/*!
+		 * Constructor.
+		 *
+		 * \param maxLine Maximum line length in bytes, 0 for no limit.
+		 */
+		ReplIO(size_t maxLine = 0);
 
 		~ReplIO();
 
+		/*!
+		 * Read all pending input and move to the next complete line.
+		 *
+		 * \return Number of tokens in the line, 0 if no line is available yet.
+		 */
 		size_t available();
 
+		/*!
+		 * Write all pending output and block until input arrives, meanwhile
+		 * run the reactor for task commands.
+		 *
+		 * \return `false` if the input was closed, `true` otherwise.
+		 */
+		bool wait();
+
 		/*!
 		 * Check whether a line ending was encountered.
 		 *
@@ -28,18 +53,60 @@ namespace commandIO {
 		 * Flush the input.
 		 */
 		void flush();
-		char *read();
-		void write(string const &) const;
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Write data.
+		 *
+		 * \param data Data.
+		 * \param size Size of `data`.
+		 */
+		void write(char const *, size_t);
+
+		/*!
+		 * Write one string.
+		 *
+		 * \param data String.
+		 */
+		void write(string const &);
+
+		/*!
+		 * Write a region of a file.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Mark the end of a command's output.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		void endCommand(bool);
 
 		bool interactive{ true };
+		OutputBuffer output{ fileno(stdout) };
+		Format format;
+		Session session;
+		size_t tasks{ 0 }; ///< Task commands in flight.
 
 	private:
-		void store_(int);
-
-		char *data_{ new char[100] };
-		size_t index_{ 0 };
-		size_t offset_{ 0 };
-		bool escape_{ false };
-		bool quoted_{ false };
+		InputBuffer input_;
+		int fd_{ fileno(stdin) };
+		int flags_;
+		bool closed_{ false };
 	};
 }
@@ -0,0 +1,165 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../error.hpp"
+#include "../../reactor.hpp"
+#include "io.hpp"
+
+namespace commandIO {
+
+	using std::to_string;
+
+	ScriptIO::ScriptIO(char const *path, bool stopOnError, size_t maxLine)
+			: input_(maxLine), stopOnError_{ stopOnError },
+				start_{ std::chrono::steady_clock::now() } {
+		int fd{ open(path, O_RDONLY) };
+		struct stat status;
+
+		if (fd == -1) {
+			closed_ = true;
+			return;
+		}
+		if (fstat(fd, &status) == -1) {
+			close(fd);
+			closed_ = true;
+			return;
+		}
+
+		/*
+		 * Tokenizing writes to every page of the mapping, private pages keep
+		 * the file intact at the cost of a copy of every page on first write.
+		 */
+		size_ = status.st_size;
+		if (size_) {
+			void *data{ mmap(
+					nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) };
+
+			if (data == MAP_FAILED) {
+				close(fd);
+				closed_ = true;
+				return;
+			}
+			data_ = static_cast<char *>(data);
+			madvise(data_, size_, MADV_SEQUENTIAL);
+		}
+		close(fd);
+
+		input_.assign(data_, size_);
+		good_ = true;
+	}
+
+	ScriptIO::~ScriptIO() {
+		if (data_) {
+			munmap(data_, size_);
+		}
+	}
+
+	size_t ScriptIO::available() {
+		if (stopped_) {
+			return 0;
+		}
+
+		size_t size{ input_.next() };
+
+		if (not size and not closed_) {
+			closed_ = not input_.receive();
+			size = input_.next();
+		}
+
+		if (input_.overflow()) {
+			write(
+					errorMessages[Error::LINE_TOO_LONG] + to_string(input_.maxLine) +
+					"\n");
+			errors++;
+			if (stopOnError_) {
+				closed_ = stopped_ = true;
+				return 0;
+			}
+		}
+
+		return size;
+	}
+
+	bool ScriptIO::wait() {
+		Reactor &reactor{ Reactor::local() };
+
+		output.flush();
+		if (closed_) {
+			while (tasks and reactor.pending()) {
+				reactor.run();
+				output.flush();
+			}
+		}
+
+		return not closed_;
+	}
+
+	bool ScriptIO::eol() const {
+		return input_.eol();
+	}
+
+	void ScriptIO::flush() {
+		input_.flush();
+	}
+
+	string_view ScriptIO::read() {
+		return input_.read();
+	}
+
+	string_view ScriptIO::back() const {
+		return input_.back();
+	}
+
+	void ScriptIO::write(char const *data, size_t size) {
+		output.write(data, size);
+	}
+
+	void ScriptIO::write(string const &data) {
+		output.write(data.data(), data.size());
+	}
+
+	void ScriptIO::write(FileRegion const &region) {
+		output.write(region);
+	}
+
+	void ScriptIO::endCommand(bool success) {
+		endCommand(success, input_.line());
+	}
+
+	void ScriptIO::endCommand(bool success, size_t line) {
+		commands++;
+		if (not success) {
+			errors++;
+			write("Error on line " + to_string(line) + ".\n");
+			if (stopOnError_) {
+				closed_ = stopped_ = true;
+			}
+		}
+		if (tasks) {
+			Reactor::local().run(0);
+		}
+		output.endCommand();
+	}
+
+	bool ScriptIO::good() const {
+		return good_;
+	}
+
+	size_t ScriptIO::line() const {
+		return input_.line();
+	}
+
+	void ScriptIO::summary() {
+		double seconds{ std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start_).count() };
+		string text{
+				to_string(commands) + " commands, " + to_string(errors) +
+				" errors in " + to_string(seconds) + " s (" +
+				to_string(seconds > 0 ? commands / seconds : 0) + " commands/s)\n" };
+
+		output.flush();
+		::write(fileno(stderr), text.data(), text.size());
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "../../input.hpp"
+#include "../../output.hpp"
+#include "../../session.hpp"
+
+namespace commandIO {
+
+	using std::string;
+	using std::string_view;
+
+	/**
+	 * Input from a script file and output.
+	 *
+	 * The script is mapped into memory and its commands are executed
+	 * back-to-back without a prompt. Failing commands are reported with their
+	 * line number.
+	 *
+	 * The mapping is private and tokenized in place, so every page of the
+	 * script is copied once it is read. Memory use grows to the size of the
+	 * script.
+	 */
+	class ScriptIO {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param path Script file name.
+		 * \param stopOnError Stop at the first failing command.
+		 * \param maxLine Maximum line length in bytes, 0 for no limit.
+		 */
+		ScriptIO(char const *, bool = false, size_t = 0);
+
+		~ScriptIO();
+
+		/*!
+		 * Move to the next complete line.
+		 *
+		 * \return Number of tokens in the line, 0 if no line is available.
+		 */
+		size_t available();
+
+		/*!
+		 * Wait for input, the whole script is available at once. Task commands
+		 * in flight are completed at the end of the script.
+		 *
+		 * \return `false` if the script has ended, `true` otherwise.
+		 */
+		bool wait();
+
+		/*!
+		 * Check whether a line ending was encountered.
+		 *
+		 * \return `true` if a line ending was encountered, `false` otherwise.
+		 */
+		bool eol() const;
+
+		/**
+		 * Flush the input.
+		 */
+		void flush();
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Write data.
+		 *
+		 * \param data Data.
+		 * \param size Size of `data`.
+		 */
+		void write(char const *, size_t);
+
+		/*!
+		 * Write one string.
+		 *
+		 * \param data String.
+		 */
+		void write(string const &);
+
+		/*!
+		 * Write a region of a file.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Mark the end of a command's output.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		void endCommand(bool);
+
+		/*!
+		 * Mark the end of a command's output for a command that was read
+		 * earlier.
+		 *
+		 * \param success Whether the command succeeded.
+		 * \param line Line number of the command.
+		 */
+		void endCommand(bool, size_t);
+
+		/*!
+		 * Check whether the script was opened.
+		 *
+		 * \return `true` if the script was opened, `false` otherwise.
+		 */
+		bool good() const;
+
+		/*!
+		 * Line number of the current command.
+		 *
+		 * \return Line number.
+		 */
+		size_t line() const;
+
+		/*!
+		 * Write the number of commands, errors and commands per second to
+		 * standard error.
+		 */
+		void summary();
+
+		bool interactive{ false };
+		OutputBuffer output{ fileno(stdout) };
+		Format format;
+		Session session;
+		size_t tasks{ 0 }; ///< Task commands in flight.
+
+		size_t commands{ 0 };
+		size_t errors{ 0 };
+
+	private:
+		InputBuffer input_;
+		bool const stopOnError_;
+		char *data_{ nullptr };
+		size_t size_{ 0 };
+		bool good_{ false };
+		bool closed_{ false };
+		bool stopped_{ false }; ///< The remaining lines are dropped.
+		std::chrono::steady_clock::time_point start_;
+	};
+}
@@ -0,0 +1,383 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../error.hpp"
+#include "../../reactor.hpp"
+#include "../../stats.hpp"
+#include "io.hpp"
+
+namespace commandIO {
+
+	using std::to_string;
+
+	size_t const maxEvents_{ 64 };
+	int const retireInterval_{ 10 }; // Milliseconds between checks of jobs.
+	int const type_{ SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC };
+
+	SocketIO::SocketIO(int fd, size_t maxLine) : fd_{ fd }, input_(maxLine) {}
+
+	SocketIO::~SocketIO() {
+		close(fd_);
+	}
+
+	size_t SocketIO::available() {
+		size_t size{ input_.next() };
+
+		if (input_.overflow()) {
+			write(
+					errorMessages[Error::LINE_TOO_LONG] + to_string(input_.maxLine) +
+					"\n");
+		}
+
+		return size;
+	}
+
+	bool SocketIO::wait() {
+		waiting_ = true;
+
+		return false;
+	}
+
+	bool SocketIO::eol() const {
+		return input_.eol();
+	}
+
+	void SocketIO::flush() {
+		input_.flush();
+	}
+
+	string_view SocketIO::read() {
+		return input_.read();
+	}
+
+	string_view SocketIO::back() const {
+		return input_.back();
+	}
+
+	void SocketIO::write(char const *data, size_t size) {
+		output_.append(data, size);
+	}
+
+	void SocketIO::write(string const &data) {
+		output_.append(data);
+	}
+
+	void SocketIO::write(FileRegion const &region) {
+		off_t offset{ region.offset };
+		size_t size{ region.size };
+
+		// The region is copied so a slow client does not block the server.
+		while (size and region.fd != -1) {
+			size_t end{ output_.size() };
+
+			output_.resize(end + size);
+			ssize_t read{ pread(region.fd, &output_[end], size, offset) };
+
+			if (read <= 0) {
+				output_.resize(end);
+				if (read == -1 and errno == EINTR) {
+					continue;
+				}
+				break;
+			}
+			output_.resize(end + read);
+			offset += read;
+			size -= read;
+		}
+
+		if (region.owned and region.fd != -1) {
+			close(region.fd);
+		}
+	}
+
+	void SocketIO::endCommand(bool) {}
+
+	size_t SocketIO::backlog() const {
+		return output_.size() - sent_;
+	}
+
+	bool SocketIO::receive_() {
+		return input_.receive(fd_);
+	}
+
+	/*
+	 * Send as much output as the socket accepts.
+	 */
+	bool SocketIO::send_() {
+		while (backlog()) {
+			ssize_t size{
+				::send(fd_, output_.data() + sent_, backlog(), MSG_NOSIGNAL) };
+
+			if (size > 0) {
+				Stats::write(size);
+				sent_ += size;
+			} else if (errno == EAGAIN or errno == EWOULDBLOCK) {
+				return true;
+			} else if (errno != EINTR) {
+				return false;
+			}
+		}
+		output_.clear();
+		sent_ = 0;
+
+		return true;
+	}
+
+
+	SocketServer::SocketServer(char const *path, size_t maxLine)
+			: socket_{ socket(AF_UNIX, type_, 0) }, maxLine_{ maxLine } {
+		sockaddr_un address{};
+
+		if (socket_ == -1 or strlen(path) >= sizeof(address.sun_path)) {
+			return;
+		}
+		address.sun_family = AF_UNIX;
+		strcpy(address.sun_path, path);
+		unlink(path);
+
+		if (
+				bind(socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ==
+				-1) {
+			return;
+		}
+		path_ = path;
+		listen_();
+	}
+
+	SocketServer::SocketServer(unsigned short port, size_t maxLine)
+			: socket_{ socket(AF_INET, type_, 0) }, maxLine_{ maxLine } {
+		sockaddr_in address{};
+		int reuse{ 1 };
+
+		if (socket_ == -1) {
+			return;
+		}
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+		if (
+				bind(socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ==
+				-1) {
+			return;
+		}
+		listen_();
+	}
+
+	SocketServer::~SocketServer() {
+		clients_.clear();
+		if (epoll_ != -1) {
+			close(epoll_);
+		}
+		if (socket_ != -1) {
+			close(socket_);
+		}
+		if (not path_.empty()) {
+			unlink(path_.c_str());
+		}
+	}
+
+	bool SocketServer::good() const {
+		return epoll_ != -1;
+	}
+
+	size_t SocketServer::clients() const {
+		return clients_.size();
+	}
+
+	void SocketServer::listen_() {
+		epoll_event event{};
+
+		if (listen(socket_, SOMAXCONN) == -1) {
+			return;
+		}
+
+		epoll_ = epoll_create1(EPOLL_CLOEXEC);
+		event.events = EPOLLIN;
+		event.data.ptr = nullptr;
+		if (
+				epoll_ != -1 and
+				epoll_ctl(epoll_, EPOLL_CTL_ADD, socket_, &event) == -1) {
+			close(epoll_);
+			epoll_ = -1;
+		}
+	}
+
+	/*
+	 * Wait for events, accept new clients, receive input and send pending
+	 * output. Clients that can make progress are collected in `ready_`.
+	 */
+	bool SocketServer::poll_(int timeout) {
+		Reactor &reactor{ Reactor::local() };
+		epoll_event events[maxEvents_];
+		bool wake{ false };
+		int count;
+
+		ready_.clear();
+		if (not good()) {
+			return false;
+		}
+		reap_();
+		if (
+				not retired_.empty() and (timeout < 0 or timeout > retireInterval_)) {
+			timeout = retireInterval_;
+		}
+
+		if (reactor_ != reactor.fd()) {
+			epoll_event event{};
+
+			reactor_ = reactor.fd();
+			event.events = EPOLLIN;
+			event.data.ptr = this;
+			epoll_ctl(epoll_, EPOLL_CTL_ADD, reactor_, &event);
+		}
+
+		count = epoll_wait(epoll_, events, maxEvents_, timeout);
+		if (count == -1) {
+			return errno == EINTR;
+		}
+
+		for (int i{ 0 }; i < count; i++) {
+			SocketIO *io{ static_cast<SocketIO *>(events[i].data.ptr) };
+
+			if (not io) {
+				accept_();
+				continue;
+			}
+			if (events[i].data.ptr == this) {
+				wake = true;
+				continue;
+			}
+
+			if (events[i].events & EPOLLERR) {
+				remove_(*io);
+				continue;
+			}
+			if (events[i].events & EPOLLOUT and not io->send_()) {
+				remove_(*io);
+				continue;
+			}
+			if (events[i].events & (EPOLLIN | EPOLLHUP) and not io->closed_) {
+				io->closed_ = not io->receive_();
+			}
+			io->queued_ = true;
+			ready_.push_back(io);
+		}
+
+		// Completed tasks may have written output or ended a client.
+		if (wake) {
+			reactor.run(0);
+			for (auto const &client: clients_) {
+				SocketIO &io{ *client.second };
+
+				if (
+						not io.queued_ and
+						(io.backlog() or io.quit_ or io.closed_ or io.removed_)) {
+					io.queued_ = true;
+					ready_.push_back(&io);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void SocketServer::accept_() {
+		int fd;
+
+		while (
+				(fd = accept4(
+						 socket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1) {
+			unique_ptr<SocketIO> io{ new SocketIO(fd, maxLine_) };
+			epoll_event event{};
+
+			event.events = EPOLLIN;
+			event.data.ptr = io.get();
+			if (epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) == -1) {
+				continue;
+			}
+			io->events_ = event.events;
+			clients_[io.get()] = std::move(io);
+		}
+	}
+
+	/*
+	 * Send pending output after a client's commands were handled and update
+	 * the events the client is waiting for. Input is not read while the
+	 * output backlog is too large.
+	 */
+	void SocketServer::update_(SocketIO &io) {
+		epoll_event event{};
+
+		io.queued_ = false;
+		if (io.removed_) {
+			remove_(io);
+			return;
+		}
+		if (not io.send_()) {
+			remove_(io);
+			return;
+		}
+		if (
+				not(io.backlog() or io.tasks) and
+				(io.quit_ or (io.closed_ and io.waiting_))) {
+			remove_(io);
+			return;
+		}
+
+		event.events = io.backlog() ? uint32_t(EPOLLOUT) : 0;
+		if (not(io.quit_ or io.closed_) and io.backlog() < maxBacklog) {
+			event.events |= EPOLLIN;
+		}
+		event.data.ptr = &io;
+		if (event.events != io.events_) {
+			epoll_ctl(epoll_, EPOLL_CTL_MOD, io.fd_, &event);
+			io.events_ = event.events;
+		}
+	}
+
+	/*
+	 * Disconnect a client. A client with tasks in flight is kept until they
+	 * have completed, their output is discarded. A client with background
+	 * jobs is retired, destroying its session would block until they finish.
+	 */
+	void SocketServer::remove_(SocketIO &io) {
+		if (not io.removed_) {
+			epoll_ctl(epoll_, EPOLL_CTL_DEL, io.fd_, nullptr);
+			io.removed_ = true;
+			io.quit_ = true;
+		}
+		if (io.tasks or io.session.busy()) {
+			io.output_.clear();
+			io.sent_ = 0;
+			if (not(io.tasks or io.retired_)) {
+				io.retired_ = true;
+				retired_.push_back(&io);
+			}
+			return;
+		}
+		clients_.erase(&io);
+	}
+
+	// Destroy retired clients whose jobs have finished.
+	void SocketServer::reap_() {
+		for (size_t i{ 0 }; i < retired_.size();) {
+			SocketIO *io{ retired_[i] };
+
+			if (io->session.busy()) {
+				i++;
+				continue;
+			}
+			retired_[i] = retired_.back();
+			retired_.pop_back();
+			clients_.erase(io);
+		}
+	}
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../../input.hpp"
+#include "../../output.hpp"
+#include "../../session.hpp"
+
+namespace commandIO {
+
+	using std::string;
+	using std::string_view;
+	using std::unique_ptr;
+	using std::unordered_map;
+	using std::vector;
+
+	/**
+	 * Input and output of one socket client.
+	 *
+	 * Input is received and output is sent by a `SocketServer`, this object
+	 * only buffers both.
+	 */
+	class SocketIO {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param fd Connected socket, closed on destruction.
+		 * \param maxLine Maximum line length in bytes, 0 for no limit.
+		 */
+		SocketIO(int, size_t = 0);
+
+		~SocketIO();
+
+		/*!
+		 * Move to the next complete line.
+		 *
+		 * \return Number of tokens in the line, 0 if no line is available yet.
+		 */
+		size_t available();
+
+		/*!
+		 * Give control back to the server until more input arrives.
+		 *
+		 * \return `false`.
+		 */
+		bool wait();
+
+		/*!
+		 * Check whether a line ending was encountered.
+		 *
+		 * \return `true` if a line ending was encountered, `false` otherwise.
+		 */
+		bool eol() const;
+
+		/**
+		 * Flush the input.
+		 */
+		void flush();
+
+		/*!
+		 * Read one token.
+		 *
+		 * \return Token.
+		 */
+		string_view read();
+
+		/*!
+		 * Last token of the current line.
+		 *
+		 * \return Token.
+		 */
+		string_view back() const;
+
+		/*!
+		 * Write data.
+		 *
+		 * \param data Data.
+		 * \param size Size of `data`.
+		 */
+		void write(char const *, size_t);
+
+		/*!
+		 * Write one string.
+		 *
+		 * \param data String.
+		 */
+		void write(string const &);
+
+		/*!
+		 * Write a region of a file.
+		 *
+		 * \param region File region.
+		 */
+		void write(FileRegion const &);
+
+		/*!
+		 * Mark the end of a command's output.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		void endCommand(bool);
+
+		/*!
+		 * Size of the output that has not been sent yet.
+		 *
+		 * \return Number of bytes.
+		 */
+		size_t backlog() const;
+
+		bool interactive{ false };
+		Format format;
+		Session session;
+		size_t tasks{ 0 }; ///< Task commands in flight.
+
+	private:
+		friend class SocketServer;
+
+		bool receive_();
+		bool send_();
+
+		int const fd_;
+		InputBuffer input_;
+		string output_;
+		size_t sent_{ 0 };
+		uint32_t events_{ 0 }; ///< Registered epoll events.
+		bool waiting_{ false }; ///< All received lines were handled.
+		bool closed_{ false }; ///< No more input.
+		bool quit_{ false }; ///< Disconnect once output is sent.
+		bool removed_{ false }; ///< Disconnected, kept until its tasks complete.
+		bool retired_{ false }; ///< Disconnected, kept until its jobs finish.
+		bool queued_{ false }; ///< In the ready list of the server.
+	};
+
+	/**
+	 * Server for many clients on a Unix domain socket or a localhost TCP
+	 * port.
+	 *
+	 * Clients are multiplexed in a single thread with epoll, every client has
+	 * its own `SocketIO` with input and output buffers. A client is
+	 * disconnected when it sends `exit` or closes its connection. The reactor
+	 * of the thread is run as part of the loop, so task commands of all
+	 * clients make progress.
+	 */
+	class SocketServer {
+	public:
+		/*!
+		 * Listen on a Unix domain socket.
+		 *
+		 * \param path Socket file name, an existing file is replaced.
+		 * \param maxLine Maximum line length in bytes, 0 for no limit.
+		 */
+		SocketServer(char const *, size_t = 0);
+
+		/*!
+		 * Listen on a TCP port of the loopback interface.
+		 *
+		 * \param port Port number.
+		 * \param maxLine Maximum line length in bytes, 0 for no limit.
+		 */
+		SocketServer(unsigned short, size_t = 0);
+
+		~SocketServer();
+
+		/*!
+		 * Check whether the server is listening.
+		 *
+		 * \return `true` if the server is listening, `false` otherwise.
+		 */
+		bool good() const;
+
+		/*!
+		 * Number of connected clients.
+		 *
+		 * \return Number of clients.
+		 */
+		size_t clients() const;
+
+		/*!
+		 * Wait for events and handle the commands of all clients that sent
+		 * input.
+		 *
+		 * \param commands Interface.
+		 * \param timeout Timeout in milliseconds, -1 to wait indefinitely.
+		 *
+		 * \return `false` if the server failed, `true` otherwise.
+		 */
+		template <class C>
+		bool step(C const &commands, int timeout = -1) {
+			if (not poll_(timeout)) {
+				return false;
+			}
+
+			for (SocketIO *io: ready_) {
+				bool more{ not io->quit_ };
+
+				io->waiting_ = false;
+				while (more and io->backlog() < maxBacklog) {
+					more = commands.step(*io);
+				}
+				if (not(more or io->waiting_)) {
+					io->quit_ = true;
+				}
+				update_(*io);
+			}
+
+			return true;
+		}
+
+		/*!
+		 * Handle commands until the server fails.
+		 *
+		 * \param commands Interface.
+		 */
+		template <class C>
+		void run(C const &commands) {
+			while (step(commands)) {}
+		}
+
+		size_t maxBacklog{ 1 << 20 }; ///< Stop reading from a client above this.
+
+	private:
+		void listen_();
+		bool poll_(int);
+		void accept_();
+		void update_(SocketIO &);
+		void remove_(SocketIO &);
+		void reap_();
+
+		int socket_;
+		int epoll_{ -1 };
+		size_t const maxLine_;
+		string path_;
+		int reactor_{ -1 }; ///< Registered reactor file descriptor.
+		unordered_map<SocketIO *, unique_ptr<SocketIO>> clients_;
+		vector<SocketIO *> ready_;
+		vector<SocketIO *> retired_;
+	};
+}
@@ -1,13 +1,50 @@
 #pragma once
 
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "output.hpp"
 
 namespace commandIO {
 	/**
 	 * Print functions.
+	 *
+	 * Values are passed by reference all the way to the output buffer, large
+	 * strings, views and file regions are written without being copied.
+	 *
+	 * Values of user defined types can be printed by providing an overload
+	 * `template <class I> void print(I &io, T const &data)` in the namespace
+	 * of `T`, types that have an `operator<<` are printed with that operator.
 	 */
+	using std::declval;
+	using std::is_arithmetic_v;
+	using std::is_same_v;
+	using std::ostringstream;
 	using std::string;
-	using std::to_string;
+	using std::string_view;
+	using std::to_chars;
+	using std::to_chars_result;
+	using std::void_t;
+
+	// Detect types that can be iterated over.
+	template <class T, class = void>
+	struct isRange_ : std::false_type {};
+
+	template <class T>
+	struct isRange_<
+			T, void_t<
+					decltype(std::begin(declval<T const &>())),
+					decltype(std::end(declval<T const &>()))>> : std::true_type {};
 
 	/**
 	 * Print a C string.
@@ -16,9 +53,8 @@ namespace commandIO {
 	 * \param data C string.
 	 */
 	template <class I>
-	void print(I& io, const char* data) {
-	  string s {data};
-	  io.write(s);
+	void print(I &io, const char *data) {
+		io.write(data, strlen(data));
 	}
 
 	/**
@@ -28,20 +64,84 @@ namespace commandIO {
 	 * \param data String.
 	 */
 	template <class I>
-	void print(I& io, string& data) {
-	  io.write(data);
+	void print(I &io, string const &data) {
+		io.write(data.data(), data.size());
 	}
 
 	/**
-	 * Print a value of basic type.
+	 * Print a string view.
+	 *
+	 * \param io Input / output object.
+	 * \param data String view.
+	 */
+	template <class I>
+	void print(I &io, string_view data) {
+		io.write(data.data(), data.size());
+	}
+
+#ifdef __cpp_lib_span
+	/**
+	 * Print a span of characters.
+	 *
+	 * \param io Input / output object.
+	 * \param data Characters.
+	 */
+	template <class I>
+	void print(I &io, std::span<char const> data) {
+		io.write(data.data(), data.size());
+	}
+#endif
+
+	/**
+	 * Print a region of a file.
+	 *
+	 * \param io Input / output object.
+	 * \param data File region.
+	 */
+	template <class I>
+	void print(I &io, FileRegion const &data) {
+		io.write(data);
+	}
+
+	/**
+	 * Print a value.
+	 *
+	 * Numbers are formatted with `to_chars()`, floating point numbers use the
+	 * shortest representation that reads back to the same value. Elements of
+	 * containers are separated by `io.format.separator` and enclosed by
+	 * `io.format.open` and `io.format.close`.
 	 *
 	 * \param io Input / output object.
 	 * \param data Data.
 	 */
 	template <class I, class T>
-	void print(I& io, T data) {
-	  string s {to_string(data)};
-	  io.write(s);
+	void print(I &io, T const &data) {
+		if constexpr (is_same_v<T, bool>) {
+			io.write(data ? "1" : "0", 1);
+		} else if constexpr (is_same_v<T, char>) {
+			io.write(&data, 1);
+		} else if constexpr (is_arithmetic_v<T>) {
+			char buffer[128];
+			to_chars_result result{
+				to_chars(buffer, buffer + sizeof(buffer), data) };
+			io.write(buffer, result.ptr - buffer);
+		} else if constexpr (isRange_<T>::value) {
+			bool first{ true };
+
+			print(io, io.format.open);
+			for (auto const &element: data) {
+				if (not first) {
+					print(io, io.format.separator);
+				}
+				print(io, element);
+				first = false;
+			}
+			print(io, io.format.close);
+		} else {
+			ostringstream oss;
+			oss << data;
+			print(io, oss.str());
+		}
 	}
 
 	/**
@@ -52,8 +152,8 @@ namespace commandIO {
 	 * \param args Remaining values.
 	 */
 	template <class I, class H, class... Tail>
-	void print(I& io, H data, Tail... args) {
-	  print(io, data);
-	  print(io, args...);
+	void print(I &io, H const &data, Tail const &...args) {
+		print(io, data);
+		print(io, args...);
 	}
 }
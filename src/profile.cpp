@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "profile.hpp"
+
+namespace commandIO {
+
+	namespace {
+		// Time below which a fraction `q` of the sorted times fall.
+		uint64_t percentile_(vector<uint64_t> const &times, double q) {
+			return times[std::min(
+					times.size() - 1, size_t(q * double(times.size())))];
+		}
+	}
+
+	char const *const PerfCounters::names[size]{
+		"cycles", "instructions", "cache misses", "branch misses" };
+
+	PerfCounters::PerfCounters() {
+#ifdef __linux__
+		static uint64_t const events[size]{
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+		for (size_t i{ 0 }; i < size; i++) {
+			perf_event_attr attr;
+
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = events[i];
+			attr.disabled = not i;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+
+			fds_[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, fds_[0], 0));
+			if (fds_[i] < 0) {
+				// All or nothing, a partial group is not reported.
+				close_();
+				return;
+			}
+		}
+#endif
+	}
+
+	PerfCounters::~PerfCounters() {
+		close_();
+	}
+
+	void PerfCounters::close_() {
+#ifdef __linux__
+		for (int &fd: fds_) {
+			if (fd >= 0) {
+				close(fd);
+			}
+			fd = -1;
+		}
+#endif
+	}
+
+	bool PerfCounters::good() const {
+		return fds_[0] >= 0;
+	}
+
+	void PerfCounters::start() {
+#ifdef __linux__
+		if (good()) {
+			ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+
+	void PerfCounters::stop() {
+#ifdef __linux__
+		if (good()) {
+			ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+
+	bool PerfCounters::read(uint64_t (&values)[size]) const {
+#ifdef __linux__
+		uint64_t group[size + 1];
+
+		if (
+				not good() or
+				::read(fds_[0], group, sizeof(group)) != ssize_t(sizeof(group)) or
+				group[0] != size) {
+			return false;
+		}
+		std::copy(group + 1, group + 1 + size, values);
+
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	string profileReport(
+			string const &name, vector<uint64_t> &times, Phases const &phases,
+			PerfCounters const &counters) {
+		string result;
+		char line[160];
+		double runs(times.size());
+		double scale{ tickNanoseconds() / 1e3 / runs };
+		uint64_t values[PerfCounters::size];
+
+		if (times.empty()) {
+			return result;
+		}
+		std::sort(times.begin(), times.end());
+
+		snprintf(line, sizeof(line), "%s: %zu runs\n", name.c_str(), times.size());
+		result += line;
+		snprintf(
+				line, sizeof(line),
+				"time us: min %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f\n",
+				times.front() / 1e3, percentile_(times, 0.5) / 1e3,
+				percentile_(times, 0.9) / 1e3, percentile_(times, 0.99) / 1e3,
+				times.back() / 1e3);
+		result += line;
+
+		uint64_t parse{ phases.total - std::min(
+															 phases.total, phases.convert + phases.call) };
+		snprintf(
+				line, sizeof(line),
+				"per run us: parse %.3f conversion %.3f function %.3f\n",
+				parse * scale, phases.convert * scale, phases.call * scale);
+		result += line;
+
+		if (not counters.read(values)) {
+			return result + "hardware counters unavailable\n";
+		}
+		result += "per run:";
+		for (size_t i{ 0 }; i < PerfCounters::size; i++) {
+			snprintf(
+					line, sizeof(line), " %.1f %s,", values[i] / runs,
+					PerfCounters::names[i]);
+			result += line;
+		}
+		snprintf(
+				line, sizeof(line), " %.2f IPC\n",
+				values[0] ? double(values[1]) / double(values[0]) : 0.0);
+		result += line;
+
+		return result;
+	}
+}
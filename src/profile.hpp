@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats.hpp"
+
+namespace commandIO {
+
+	/// \defgroup profile
+
+	using std::string;
+	using std::uint64_t;
+	using std::vector;
+
+	/*!
+	 * Time spent in the phases of a command, in ticks.
+	 *
+	 * \ingroup profile
+	 */
+	struct Phases {
+		uint64_t total{ 0 }; ///< Whole commands.
+		uint64_t convert{ 0 }; ///< Converting arguments.
+		uint64_t call{ 0 }; ///< Running the function.
+	};
+
+	/*!
+	 * Phase timing of commands that are being profiled.
+	 *
+	 * Timing is only done while a `Phases` object is attached to the thread,
+	 * otherwise the cost is a check of a thread local pointer.
+	 *
+	 * \ingroup profile
+	 */
+	class Profile {
+	public:
+		/*!
+		 * Attach phase timing to the current thread.
+		 *
+		 * \param phases Phase times, `nullptr` to stop timing.
+		 */
+		static void attach(Phases *phases) {
+			phases_ = phases;
+		}
+
+		/*!
+		 * Start of a phase.
+		 *
+		 * \return Ticks, 0 if no timing is attached.
+		 */
+		static uint64_t start() {
+			return phases_ ? ticks() : 0;
+		}
+
+		/*!
+		 * End of argument conversion.
+		 *
+		 * \param start Start of the phase.
+		 *
+		 * \return Ticks, 0 if no timing is attached.
+		 */
+		static uint64_t converted(uint64_t start) {
+			if (not phases_) {
+				return 0;
+			}
+			uint64_t end{ ticks() };
+			phases_->convert += end - start;
+			return end;
+		}
+
+		/*!
+		 * End of a function call.
+		 *
+		 * \param start Start of the phase.
+		 */
+		static void called(uint64_t start) {
+			if (phases_) {
+				phases_->call += ticks() - start;
+			}
+		}
+
+	private:
+		inline static thread_local Phases *phases_{ nullptr };
+	};
+
+	/*!
+	 * Hardware performance counters of the current thread.
+	 *
+	 * Cycles, instructions, cache misses and branch misses in user space are
+	 * counted as one group, work that is handed to other threads is not
+	 * counted. When the counters are not available, e.g., because of
+	 * `perf_event_paranoid` or a virtual machine without a PMU, `good()` is
+	 * `false` and nothing is counted.
+	 *
+	 * \ingroup profile
+	 */
+	class PerfCounters {
+	public:
+		static size_t const size{ 4 };
+
+		PerfCounters();
+		PerfCounters(PerfCounters const &) = delete;
+		PerfCounters &operator=(PerfCounters const &) = delete;
+
+		~PerfCounters();
+
+		/*!
+		 * Check whether the counters are available.
+		 *
+		 * \return `true` if the counters are available, `false` otherwise.
+		 */
+		bool good() const;
+
+		/*!
+		 * Start counting.
+		 */
+		void start();
+
+		/*!
+		 * Stop counting.
+		 */
+		void stop();
+
+		/*!
+		 * Read the counts accumulated so far.
+		 *
+		 * \param[out] values Cycles, instructions, cache misses and branch
+		 *   misses.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		bool read(uint64_t (&)[size]) const;
+
+		static char const *const names[size];
+
+	private:
+		void close_();
+
+		int fds_[size]{ -1, -1, -1, -1 };
+	};
+
+	/*!
+	 * Format a profile.
+	 *
+	 * \ingroup profile
+	 *
+	 * \param name Command name.
+	 * \param times Wall time of each run in nanoseconds, sorted by the call.
+	 * \param phases Phase times of all runs, the rest of the total is parse
+	 *   time.
+	 * \param counters Hardware counters of all runs.
+	 *
+	 * \return Report.
+	 */
+	string profileReport(
+			string const &, vector<uint64_t> &, Phases const &,
+			PerfCounters const &);
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "reactor.hpp"
+
+namespace commandIO {
+
+	using std::chrono::duration_cast;
+	using std::chrono::nanoseconds;
+
+	size_t const maxEvents_{ 64 };
+
+	Reactor::~Reactor() {
+		if (timer_ != -1) {
+			close(timer_);
+		}
+		if (epoll_ != -1) {
+			close(epoll_);
+		}
+	}
+
+	void Reactor::watch(int fd, uint32_t events, function<void()> callback) {
+		auto [watch, end]{ watches_.equal_range(fd) };
+		uint32_t wanted{ events };
+
+		open_();
+		for (; watch != end; watch++) {
+			wanted |= watch->second.events;
+		}
+		if (not register_(fd, wanted)) {
+			post(std::move(callback));
+			return;
+		}
+		watches_.emplace(fd, Watch_{ events, std::move(callback) });
+	}
+
+	void Reactor::after(Clock::duration delay, function<void()> callback) {
+		open_();
+		timers_.emplace(Clock::now() + delay, std::move(callback));
+		arm_();
+	}
+
+	void Reactor::post(function<void()> callback) {
+		open_();
+		posted_.push_back(std::move(callback));
+		if (posted_.size() == 1) {
+			arm_();
+		}
+	}
+
+	size_t Reactor::pending() const {
+		return watches_.size() + timers_.size() + posted_.size();
+	}
+
+	int Reactor::fd() {
+		open_();
+		return epoll_;
+	}
+
+	void Reactor::run(int timeout) {
+		epoll_event events[maxEvents_];
+		int count{ 0 };
+
+		if (posted_.size()) {
+			timeout = 0;
+		}
+		if (epoll_ != -1 and (watches_.size() or timers_.size() or not timeout)) {
+			count = epoll_wait(epoll_, events, maxEvents_, timeout);
+		}
+
+		for (int i{ 0 }; i < count; i++) {
+			if (events[i].data.fd == timer_) {
+				uint64_t expirations;
+				while (::read(timer_, &expirations, sizeof(expirations)) > 0) {}
+				continue;
+			}
+
+			int fd{ events[i].data.fd };
+			uint32_t ready{ events[i].events };
+			auto [watch, end]{ watches_.equal_range(fd) };
+			vector<function<void()>> due;
+			uint32_t rest{ 0 };
+
+			// Errors and hang-ups wake every callback of the file descriptor.
+			while (watch != end) {
+				if (watch->second.events & ready or ready & (EPOLLERR | EPOLLHUP)) {
+					due.push_back(std::move(watch->second.callback));
+					watch = watches_.erase(watch);
+				} else {
+					rest |= watch->second.events;
+					watch++;
+				}
+			}
+			if (rest) {
+				register_(fd, rest);
+			}
+			for (function<void()> &callback: due) {
+				callback();
+			}
+		}
+		expire_();
+
+		vector<function<void()>> posted;
+		posted.swap(posted_);
+		arm_();
+		for (function<void()> &callback: posted) {
+			callback();
+		}
+	}
+
+	Reactor &Reactor::local() {
+		thread_local Reactor reactor;
+		return reactor;
+	}
+
+	// Open the epoll and timer file descriptors on first use.
+	void Reactor::open_() {
+		epoll_event event{};
+
+		if (epoll_ != -1) {
+			return;
+		}
+
+		epoll_ = epoll_create1(EPOLL_CLOEXEC);
+		timer_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		event.events = EPOLLIN;
+		event.data.fd = timer_;
+		epoll_ctl(epoll_, EPOLL_CTL_ADD, timer_, &event);
+	}
+
+	/*
+	 * Wait for `events` on a file descriptor, once. A one-shot registration
+	 * stays in place after it fired and is modified from then on.
+	 */
+	bool Reactor::register_(int fd, uint32_t events) {
+		epoll_event event{};
+
+		event.events = events | EPOLLONESHOT;
+		event.data.fd = fd;
+
+		return epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) != -1 or
+			(errno == EEXIST and epoll_ctl(epoll_, EPOLL_CTL_MOD, fd, &event) != -1);
+	}
+
+	/*
+	 * Arm the timer for the earliest timer callback. Posted callbacks make
+	 * the timer expire right away, so `fd()` becomes readable.
+	 */
+	void Reactor::arm_() {
+		itimerspec value{};
+
+		if (posted_.size()) {
+			value.it_value.tv_nsec = 1;
+		} else if (timers_.size()) {
+			nanoseconds::rep delay{ std::max(
+					duration_cast<nanoseconds>(timers_.begin()->first - Clock::now())
+							.count(),
+					nanoseconds::rep(1)) };
+
+			value.it_value.tv_sec = delay / 1000000000;
+			value.it_value.tv_nsec = delay % 1000000000;
+		}
+		timerfd_settime(timer_, 0, &value, nullptr);
+	}
+
+	// Call all timer callbacks that are due.
+	void Reactor::expire_() {
+		vector<function<void()>> due;
+		Clock::time_point now{ Clock::now() };
+
+		while (timers_.size() and timers_.begin()->first <= now) {
+			due.push_back(std::move(timers_.begin()->second));
+			timers_.erase(timers_.begin());
+		}
+		if (due.empty()) {
+			return;
+		}
+		arm_();
+
+		for (function<void()> &callback: due) {
+			callback();
+		}
+	}
+}
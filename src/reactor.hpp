@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace commandIO {
+
+	/// \defgroup reactor
+
+	using std::function;
+	using std::multimap;
+	using std::unordered_multimap;
+	using std::vector;
+
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * Event loop for file descriptors and timers.
+	 *
+	 * Every thread has its own reactor, the input / output objects run it
+	 * while they wait for input. Callbacks are called once.
+	 *
+	 * \ingroup reactor
+	 */
+	class Reactor {
+	public:
+		Reactor() {}
+
+		Reactor(Reactor const &) = delete;
+
+		~Reactor();
+
+		/**
+		 * Call a function once a file descriptor is ready.
+		 *
+		 * Files that cannot be watched, like regular files, are ready
+		 * immediately. Several callbacks can wait for the same file
+		 * descriptor, each is called when its events occur.
+		 *
+		 * \param fd File descriptor.
+		 * \param events Epoll events, `EPOLLIN` or `EPOLLOUT`.
+		 * \param callback Callback.
+		 */
+		void watch(int, uint32_t, function<void()>);
+
+		/**
+		 * Call a function after a delay.
+		 *
+		 * \param delay Delay.
+		 * \param callback Callback.
+		 */
+		void after(Clock::duration, function<void()>);
+
+		/**
+		 * Call a function on the next run.
+		 *
+		 * \param callback Callback.
+		 */
+		void post(function<void()>);
+
+		/**
+		 * Number of callbacks that have not been called yet.
+		 *
+		 * \return Number of callbacks.
+		 */
+		size_t pending() const;
+
+		/**
+		 * File descriptor that is readable when callbacks are due.
+		 *
+		 * \return File descriptor.
+		 */
+		int fd();
+
+		/**
+		 * Wait for events and call the callbacks that are due.
+		 *
+		 * \param timeout Timeout in milliseconds, -1 to wait until a callback is
+		 *   due.
+		 */
+		void run(int = -1);
+
+		/**
+		 * Reactor of the current thread.
+		 *
+		 * \return Reactor.
+		 */
+		static Reactor &local();
+
+	private:
+		struct Watch_ {
+			uint32_t events;
+			function<void()> callback;
+		};
+
+		void open_();
+		bool register_(int, uint32_t);
+		void arm_();
+		void expire_();
+
+		int epoll_{ -1 };
+		int timer_{ -1 }; ///< Timer fd armed for the earliest callback.
+		unordered_multimap<int, Watch_> watches_;
+		multimap<Clock::time_point, function<void()>> timers_;
+		vector<function<void()>> posted_;
+	};
+}
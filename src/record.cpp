@@ -0,0 +1,161 @@
+#include <cinttypes>
+
+#include "input.hpp"
+#include "record.hpp"
+
+namespace commandIO {
+
+	namespace {
+		// Percentile of sorted latencies.
+		uint64_t percentile_(vector<uint64_t> const &latencies, double q) {
+			if (latencies.empty()) {
+				return 0;
+			}
+			return latencies[std::min(
+					latencies.size() - 1, size_t(q * double(latencies.size())))];
+		}
+
+		// Quote a token so that it is read back unchanged.
+		string quote_(string const &token) {
+			if (
+					not token.empty() and
+					token.find_first_of(" \t\n\"\\") == string::npos) {
+				return token;
+			}
+
+			string result{ "\"" };
+			for (char c: token) {
+				if (c == '"' or c == '\\') {
+					result += '\\';
+				}
+				result += c;
+			}
+			return result + "\"";
+		}
+	}
+
+	uint64_t hash(uint64_t hash, char const *data, size_t size) {
+		for (size_t i{ 0 }; i < size; i++) {
+			hash = (hash ^ uint8_t(data[i])) * 0x100000001b3;
+		}
+		return hash;
+	}
+
+	Recording::~Recording() {
+		if (file_) {
+			fclose(file_);
+		}
+	}
+
+	bool Recording::open(char const *path, bool interactive) {
+		file_ = fopen(path, "w");
+		if (not file_) {
+			return false;
+		}
+		this->interactive = interactive;
+		fprintf(file_, "commandIO-recording 1 %d\n", interactive);
+
+		return true;
+	}
+
+	bool Recording::load(char const *path) {
+		FILE *file{ fopen(path, "r") };
+		vector<char> data;
+		char buffer[65536];
+		size_t size;
+
+		if (not file) {
+			return false;
+		}
+		while ((size = fread(buffer, 1, sizeof(buffer), file))) {
+			data.insert(data.end(), buffer, buffer + size);
+		}
+		fclose(file);
+
+		InputBuffer input;
+		input.assign(data.data(), data.size());
+
+		if (
+				not(input.next() or (input.receive() and input.next())) or
+				input.read() != "commandIO-recording" or input.read() != "1") {
+			return false;
+		}
+		interactive = input.read() == "1";
+
+		while (input.next() or (input.receive() and input.next())) {
+			Record record;
+
+			record.delay = strtoull(string(input.read()).c_str(), nullptr, 10);
+			record.hash = strtoull(string(input.read()).c_str(), nullptr, 16);
+			while (not input.eol()) {
+				record.tokens.emplace_back(input.read());
+			}
+			if (record.tokens.empty()) {
+				return false;
+			}
+			records.push_back(std::move(record));
+		}
+
+		return true;
+	}
+
+	void Recording::add(Record &&record) {
+		if (file_) {
+			fprintf(file_, "%" PRIu64 " %016" PRIx64, record.delay, record.hash);
+			for (string const &token: record.tokens) {
+				fprintf(file_, " %s", quote_(token).c_str());
+			}
+			fputc('\n', file_);
+			fflush(file_);
+		}
+		records.push_back(std::move(record));
+	}
+
+	uint64_t Report::percentile(double q) const {
+		return percentile_(latencies, q);
+	}
+
+	uint64_t Report::percentile(string const &name, double q) const {
+		auto command{ commandLatencies.find(name) };
+
+		if (command == commandLatencies.end()) {
+			return 0;
+		}
+		return percentile_(command->second, q);
+	}
+
+	void Report::summary(Recording const &recording, FILE *out) const {
+		fprintf(
+				out,
+				"%zu commands in %f s (%f commands/s)\n"
+				"latency p50 %" PRIu64 " ns, p99 %" PRIu64 " ns, p999 %" PRIu64
+				" ns\n",
+				commands, seconds, commands / seconds, percentile(0.5),
+				percentile(0.99), percentile(0.999));
+
+		for (auto const &command: commandLatencies) {
+			vector<uint64_t> const &latencies{ command.second };
+
+			fprintf(
+					out,
+					"  %s: %zu commands, p50 %" PRIu64 " ns, p99 %" PRIu64
+					" ns, p999 %" PRIu64 " ns\n",
+					quote_(command.first).c_str(), latencies.size(),
+					percentile_(latencies, 0.5), percentile_(latencies, 0.99),
+					percentile_(latencies, 0.999));
+		}
+		fprintf(out, "%zu mismatches\n", mismatches.size());
+
+		for (size_t i{ 0 }; i < mismatches.size() and i < 10; i++) {
+			Mismatch const &mismatch{ mismatches[i] };
+
+			fprintf(
+					out, "  session %zu, command %zu:", mismatch.session,
+					mismatch.command + 1);
+			for (string const &token: recording.records[mismatch.command].tokens) {
+				fprintf(out, " %s", quote_(token).c_str());
+			}
+			fputc('\n', out);
+		}
+	}
+}
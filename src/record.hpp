@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "builtins.hpp"
+#include "lock.hpp"
+#include "output.hpp"
+#include "plugins/memory/io.hpp"
+#include "session.hpp"
+
+namespace commandIO {
+
+	/// \defgroup record
+
+	using std::map;
+	using std::string;
+	using std::string_view;
+	using std::thread;
+	using std::uint64_t;
+	using std::vector;
+
+	uint64_t const hashBasis{ 0xcbf29ce484222325 }; ///< FNV-1a offset basis.
+
+	/*!
+	 * Update an FNV-1a hash.
+	 *
+	 * \ingroup record
+	 *
+	 * \param hash Hash so far.
+	 * \param data Data.
+	 * \param size Size of `data`.
+	 *
+	 * \return Updated hash.
+	 */
+	uint64_t hash(uint64_t, char const *, size_t);
+
+	/*!
+	 * One recorded command.
+	 *
+	 * \ingroup record
+	 */
+	struct Record {
+		uint64_t delay; ///< Microseconds since the previous command arrived.
+		uint64_t hash; ///< Hash of the output of the command.
+		vector<string> tokens; ///< Command line.
+	};
+
+	/*!
+	 * Recorded session.
+	 *
+	 * A recording is a text file with a header line followed by one line per
+	 * command: the delay in microseconds, the output hash in hexadecimal and
+	 * the command tokens, quoted where needed.
+	 *
+	 * \ingroup record
+	 */
+	class Recording {
+	public:
+		Recording() = default;
+		Recording(Recording const &) = delete;
+		Recording &operator=(Recording const &) = delete;
+
+		~Recording();
+
+		/*!
+		 * Write commands to a file as they are added.
+		 *
+		 * \param path File name.
+		 * \param interactive Whether the session is interactive.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		bool open(char const *, bool);
+
+		/*!
+		 * Read a recording.
+		 *
+		 * \param path File name.
+		 *
+		 * \return `true` on success, `false` otherwise.
+		 */
+		bool load(char const *);
+
+		/*!
+		 * Add a command.
+		 *
+		 * \param record Command.
+		 */
+		void add(Record &&);
+
+		vector<Record> records;
+		bool interactive{ false }; ///< Recorded from an interactive session.
+
+	private:
+		FILE *file_{ nullptr };
+	};
+
+	/**
+	 * Input / output object that records the commands of another one.
+	 *
+	 * The arrival time, the tokens and a hash of the output of every command
+	 * are added to a recording. Output outside of a command, e.g., the prompt,
+	 * is not part of the hash.
+	 *
+	 * \ingroup record
+	 *
+	 * \tparam I Input / output object type.
+	 */
+	template <class I>
+	class Recorder {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/*!
+		 * Constructor.
+		 *
+		 * \param io Input / output object.
+		 * \param recording Recording.
+		 */
+		Recorder(I &io, Recording &recording)
+				: interactive{ io.interactive }, builtins{ builtins_(io, 0) },
+					format{ io.format },
+					session{ io.session }, tasks{ io.tasks }, io_{ io },
+					recording_{ recording }, last_{ Clock::now() } {}
+
+		~Recorder() {
+			if (pending_) {
+				end_();
+			}
+		}
+
+		size_t available() {
+			size_t size{ io_.available() };
+
+			if (size) {
+				start_();
+			}
+			return size;
+		}
+
+		bool wait() {
+			return io_.wait();
+		}
+
+		bool eol() const {
+			return io_.eol();
+		}
+
+		void flush() {
+			drain_();
+			io_.flush();
+		}
+
+		string_view read() {
+			start_();
+			string_view token{ io_.read() };
+			tokens_.emplace_back(token);
+			return token;
+		}
+
+		string_view back() const {
+			return io_.back();
+		}
+
+		void write(char const *data, size_t size) {
+			if (pending_) {
+				hash_ = hash(hash_, data, size);
+			}
+			io_.write(data, size);
+		}
+
+		void write(string const &data) {
+			write(data.data(), data.size());
+		}
+
+		// File contents are not read, only the region size is recorded.
+		void write(FileRegion const &region) {
+			if (pending_) {
+				string size{ std::to_string(region.size) };
+				hash_ = hash(hash_, size.data(), size.size());
+			}
+			io_.write(region);
+		}
+
+		void endCommand(bool success) {
+			start_();
+			end_();
+			io_.endCommand(success);
+		}
+
+		bool &interactive;
+		unsigned const builtins; ///< See `Builtin`.
+		Format &format;
+		Session &session;
+		size_t &tasks;
+
+	private:
+		// A command arrived, not every input / output object reports input
+		// through `available()` before it is read.
+		void start_() {
+			if (not pending_) {
+				pending_ = true;
+				arrival_ = Clock::now();
+			}
+		}
+
+		// Keep the tokens that the command did not read.
+		void drain_() {
+			while (not io_.eol()) {
+				tokens_.emplace_back(io_.read());
+			}
+		}
+
+		void end_() {
+			drain_();
+			recording_.add(
+					{ uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+												 arrival_ - last_)
+												 .count()),
+						hash_, std::move(tokens_) });
+			last_ = arrival_;
+			hash_ = hashBasis;
+			tokens_.clear();
+			pending_ = false;
+		}
+
+		I &io_;
+		Recording &recording_;
+		Clock::time_point last_;
+		Clock::time_point arrival_;
+		uint64_t hash_{ hashBasis };
+		vector<string> tokens_;
+		bool pending_{ false };
+	};
+
+	/*!
+	 * Replay settings.
+	 *
+	 * \ingroup record
+	 */
+	struct ReplayOptions {
+		double speed{ 1 }; ///< Multiple of the recorded speed, 0 for no delays.
+		size_t sessions{ 1 }; ///< Number of concurrent sessions.
+	};
+
+	/*!
+	 * Command whose output differs from the recording.
+	 *
+	 * \ingroup record
+	 */
+	struct Mismatch {
+		size_t session;
+		size_t command; ///< Index of the command in the recording.
+	};
+
+	/*!
+	 * Replay results.
+	 *
+	 * \ingroup record
+	 */
+	struct Report {
+		size_t commands{ 0 };
+		double seconds{ 0 }; ///< Wall clock time.
+		vector<uint64_t> latencies; ///< Sorted latencies in nanoseconds.
+		map<string, vector<uint64_t>> commandLatencies; ///< Per command name.
+		vector<Mismatch> mismatches;
+
+		/*!
+		 * Latency percentile.
+		 *
+		 * \param q Quantile, e.g., 0.99.
+		 *
+		 * \return Latency in nanoseconds.
+		 */
+		uint64_t percentile(double) const;
+
+		/*!
+		 * Latency percentile of one command.
+		 *
+		 * \param name Command name.
+		 * \param q Quantile, e.g., 0.99.
+		 *
+		 * \return Latency in nanoseconds.
+		 */
+		uint64_t percentile(string const &, double) const;
+
+		/*!
+		 * Write throughput, latency percentiles and mismatches.
+		 *
+		 * \param recording Replayed recording.
+		 * \param out Output stream.
+		 */
+		void summary(Recording const &, FILE *) const;
+	};
+
+	/*
+	 * Replay one session, latencies are measured from the scheduled start.
+	 * The latency of the n-th command of the recording is at index n.
+	 */
+	template <class C>
+	void replay_(
+			C const &commands, Recording const &recording, ReplayOptions options,
+			size_t id, vector<uint64_t> &latencies, vector<Mismatch> &mismatches) {
+		using Clock = std::chrono::steady_clock;
+
+		vector<vector<string>> lines;
+		for (Record const &record: recording.records) {
+			lines.push_back(record.tokens);
+		}
+
+		MemoryIO io(std::move(lines));
+		Recording output;
+		Recorder<MemoryIO> recorder(io, output);
+		Clock::time_point scheduled{ Clock::now() };
+
+		io.interactive = recording.interactive;
+		for (size_t i{ 0 }; i < recording.records.size(); i++) {
+			if (options.speed > 0) {
+				scheduled += std::chrono::duration_cast<Clock::duration>(
+						std::chrono::duration<double, std::micro>(
+								recording.records[i].delay / options.speed));
+				std::this_thread::sleep_until(scheduled);
+			} else {
+				scheduled = Clock::now();
+			}
+
+			if (not commands.step(recorder)) {
+				break;
+			}
+			latencies.push_back(uint64_t(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(
+							Clock::now() - scheduled)
+							.count()));
+			io.output.clear();
+
+			if (
+					output.records.size() <= i or
+					output.records[i].hash != recording.records[i].hash) {
+				mismatches.push_back({ id, i });
+			}
+		}
+	}
+
+	/*!
+	 * Replay a recording through an interface.
+	 *
+	 * Every session replays the whole recording through its own in-memory
+	 * input / output object on its own thread.
+	 *
+	 * \ingroup record
+	 *
+	 * \param commands Interface.
+	 * \param recording Recording.
+	 * \param options Replay settings.
+	 *
+	 * \return Replay results.
+	 */
+	template <class C>
+	Report replay(
+			C const &commands, Recording const &recording,
+			ReplayOptions options = {}) {
+		vector<vector<uint64_t>> latencies(options.sessions);
+		vector<vector<Mismatch>> mismatches(options.sessions);
+		vector<thread> sessions;
+		Report report;
+
+		concurrent();
+		auto start{ std::chrono::steady_clock::now() };
+		for (size_t i{ 0 }; i < options.sessions; i++) {
+			sessions.emplace_back([&, i]() {
+				replay_(
+						commands, recording, options, i, latencies[i], mismatches[i]);
+			});
+		}
+		for (thread &session: sessions) {
+			session.join();
+		}
+		report.seconds = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+
+		for (size_t i{ 0 }; i < options.sessions; i++) {
+			report.latencies.insert(
+					report.latencies.end(), latencies[i].begin(), latencies[i].end());
+			for (size_t j{ 0 }; j < latencies[i].size(); j++) {
+				vector<string> const &tokens{ recording.records[j].tokens };
+				report.commandLatencies[tokens.empty() ? "" : tokens[0]].push_back(
+						latencies[i][j]);
+			}
+			report.mismatches.insert(
+					report.mismatches.end(), mismatches[i].begin(),
+					mismatches[i].end());
+		}
+		std::sort(report.latencies.begin(), report.latencies.end());
+		for (auto &command: report.commandLatencies) {
+			std::sort(command.second.begin(), command.second.end());
+		}
+		report.commands = report.latencies.size();
+
+		return report;
+	}
+}
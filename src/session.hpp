@@ -0,0 +1,233 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace commandIO {
+
+	/// \defgroup session
+
+	using std::shared_mutex;
+	using std::unique_ptr;
+	using std::unordered_map;
+
+	class Jobs;
+
+	/**
+	 * Objects owned by one session.
+	 *
+	 * Every input / output object that supports per-session objects has a
+	 * `session` member, objects are constructed on first use and destroyed
+	 * with the session. Background jobs of the session are waited for before
+	 * any object is destroyed.
+	 *
+	 * \ingroup session
+	 */
+	class Session {
+	public:
+		Session();
+
+		~Session();
+
+		/**
+		 * Get the object made by a factory, construct it if needed.
+		 *
+		 * \param create Factory function.
+		 *
+		 * \return Object.
+		 */
+		template <class C>
+		C &get(C *(*create)()) {
+			return *static_cast<C *>(entry_(create).object.get());
+		}
+
+		/**
+		 * Get the mutex of the object made by a factory, construct the object
+		 * if needed.
+		 *
+		 * \param create Factory function.
+		 *
+		 * \return Mutex.
+		 */
+		template <class C>
+		shared_mutex &mutex(C *(*create)()) {
+			return entry_(create).mutex;
+		}
+
+		/**
+		 * Background jobs.
+		 *
+		 * \return Jobs.
+		 */
+		Jobs &jobs();
+
+		/**
+		 * Check for background jobs that have not finished, destroying the
+		 * session waits for them.
+		 *
+		 * \return `true` if jobs are running, `false` otherwise.
+		 */
+		bool busy();
+
+		bool prompt{ true }; ///< Show a prompt before the next command.
+
+	private:
+		using Key_ = void (*)();
+
+		struct Deleter_ {
+			void operator()(void *object) const {
+				destroy(object);
+			}
+
+			void (*destroy)(void *);
+		};
+
+		struct Entry_ {
+			unique_ptr<void, Deleter_> object;
+			shared_mutex mutex;
+		};
+
+		template <class C>
+		static void destroy_(void *object) {
+			delete static_cast<C *>(object);
+		}
+
+		template <class C>
+		Entry_ &entry_(C *(*create)()) {
+			std::lock_guard<std::mutex> guard{ mutex_ };
+			Entry_ &entry{ objects_[reinterpret_cast<Key_>(create)] };
+
+			if (not entry.object) {
+				entry.object = { create(), { destroy_<C> } };
+			}
+
+			return entry;
+		}
+
+		std::mutex mutex_;
+		unordered_map<Key_, Entry_> objects_;
+		unique_ptr<Jobs> jobs_; ///< Destroyed first.
+	};
+
+	/**
+	 * Class instance made per session.
+	 *
+	 * \ingroup session
+	 *
+	 * \tparam C Class.
+	 */
+	template <class C>
+	struct Factory {
+		C *(*create)(); ///< Factory function.
+	};
+
+	/**
+	 * Class instance shared by all sessions.
+	 *
+	 * \ingroup session
+	 *
+	 * \tparam C Class.
+	 */
+	template <class C>
+	struct Shared {
+		C *object; ///< Instance.
+		shared_mutex *mutex; ///< Lock of the instance, `nullptr` for none.
+	};
+
+	// Default factory function.
+	template <class C>
+	C *create_() {
+		return new C();
+	}
+
+	/**
+	 * Use a default constructed instance per session.
+	 *
+	 * \ingroup session
+	 *
+	 * \return Factory.
+	 */
+	template <class C>
+	constexpr Factory<C> factory() {
+		return { create_<C> };
+	}
+
+	/**
+	 * Use an instance per session, made by a factory function.
+	 *
+	 * All commands that use the same factory function share one instance
+	 * within a session.
+	 *
+	 * \ingroup session
+	 *
+	 * \param create Factory function, for example a lambda without captures.
+	 *
+	 * \return Factory.
+	 */
+	template <class C>
+	constexpr Factory<C> factory(C *(*create)()) {
+		return { create };
+	}
+
+	/**
+	 * Share an instance between all sessions.
+	 *
+	 * A plain pointer is shared as well, this makes the intent explicit.
+	 * Neither is locked, give a mutex for instances used by several threads.
+	 *
+	 * \ingroup session
+	 *
+	 * \param object Instance.
+	 *
+	 * \return Shared instance.
+	 */
+	template <class C>
+	constexpr Shared<C> shared(C *object) {
+		return { object, nullptr };
+	}
+
+	/**
+	 * Share an instance between all sessions, locked by a mutex.
+	 *
+	 * Keep the mutex next to the instance and give it to every command that
+	 * uses the instance.
+	 *
+	 * \ingroup session
+	 *
+	 * \param object Instance.
+	 * \param mutex Lock of the instance.
+	 *
+	 * \return Shared instance.
+	 */
+	template <class C>
+	constexpr Shared<C> shared(C *object, shared_mutex &mutex) {
+		return { object, &mutex };
+	}
+
+	/**
+	 * Instance to call a class member function on.
+	 *
+	 * \ingroup session
+	 *
+	 * \param io Input / output object.
+	 * \param object Instance, shared instance or factory.
+	 *
+	 * \return Instance.
+	 */
+	template <class I, class C>
+	C &object(I &, C *object) {
+		return *object;
+	}
+
+	template <class I, class C>
+	C &object(I &, Shared<C> const &object) {
+		return *object.object;
+	}
+
+	template <class I, class C>
+	C &object(I &io, Factory<C> const &factory) {
+		return io.session.get(factory.create);
+	}
+}
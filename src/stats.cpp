@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "stats.hpp"
+
+namespace commandIO {
+
+	namespace {
+		/*
+		 * Running threads and the sums of threads that have ended. The start
+		 * time is used to convert ticks to nanoseconds.
+		 */
+		struct Registry {
+			std::chrono::steady_clock::time_point start{
+				std::chrono::steady_clock::now() };
+			uint64_t startTicks{ ticks() };
+			mutex access;
+			std::vector<ThreadStats *> threads;
+			std::map<string, CommandTotals> retired;
+			IOTotals retiredIO;
+		};
+
+		/*
+		 * Never destroyed: threads of pools that are destroyed at exit, e.g.,
+		 * `ThreadPool::shared()`, retire their statistics after the static
+		 * objects of this file are gone.
+		 */
+		Registry &registry_() {
+			static Registry *registry{ new Registry };
+			return *registry;
+		}
+	}
+
+	// Measured over at least a millisecond since the registry was created.
+	double tickNanoseconds() {
+		using namespace std::chrono;
+
+		Registry &registry{ registry_() };
+		while (steady_clock::now() - registry.start < milliseconds(1)) {}
+
+		return duration<double, std::nano>(steady_clock::now() - registry.start)
+							 .count() /
+					 double(ticks() - registry.startTicks);
+	}
+
+	void CommandTotals::add(CommandStats const &stats) {
+		calls += stats.calls.get();
+		for (size_t i{ 0 }; i < errorKinds; i++) {
+			errors[i] += stats.errors[i].get();
+		}
+		time += stats.time.get();
+		max = std::max(max, stats.max.get());
+		for (size_t i{ 0 }; i < Histogram::size; i++) {
+			latency[i] += stats.latency.counts[i].get();
+		}
+	}
+
+	uint64_t CommandTotals::percentile(double q) const {
+		uint64_t rank{ uint64_t(q * double(calls) + 0.5) };
+		uint64_t count{ 0 };
+
+		for (size_t i{ 0 }; i < Histogram::size; i++) {
+			count += latency[i];
+			if (count and count >= rank) {
+				return std::min(max, Histogram::upper(i));
+			}
+		}
+		return max;
+	}
+
+	void IOTotals::add(IOStats const &stats) {
+		bytesRead += stats.bytesRead.get();
+		bytesWritten += stats.bytesWritten.get();
+		writes += stats.writes.get();
+		tokens += stats.tokens.get();
+	}
+
+	ThreadStats::ThreadStats() {
+		Registry &registry{ registry_() };
+		std::lock_guard<mutex> lock{ registry.access };
+		registry.threads.push_back(this);
+	}
+
+	ThreadStats::~ThreadStats() {
+		Registry &registry{ registry_() };
+		std::lock_guard<mutex> lock{ registry.access };
+
+		for (auto const &command: commands) {
+			registry.retired[command.first].add(*command.second);
+		}
+		registry.retiredIO.add(io);
+		registry.threads.erase(
+				std::find(registry.threads.begin(), registry.threads.end(), this));
+	}
+
+	CommandStats &ThreadStats::add_(char const *name) {
+		std::lock_guard<mutex> lock{ access };
+		return *(commands[name] = std::make_unique<CommandStats>());
+	}
+
+	Snapshot Stats::snapshot() {
+		Registry &registry{ registry_() };
+		std::lock_guard<mutex> lock{ registry.access };
+		Snapshot result{ registry.retired, registry.retiredIO };
+
+		for (ThreadStats *thread: registry.threads) {
+			std::lock_guard<mutex> lock{ thread->access };
+
+			for (auto const &command: thread->commands) {
+				result.commands[command.first].add(*command.second);
+			}
+			result.io.add(thread->io);
+		}
+
+		return result;
+	}
+
+	string Stats::report() {
+#ifdef COMMANDIO_NO_STATS
+		return "Statistics are disabled.\n";
+#else
+		Snapshot totals{ snapshot() };
+		IOTotals const &io{ totals.io };
+		string result;
+		char line[160];
+		double scale{ tickNanoseconds() / 1e3 };
+
+		result += "command\t\tcalls\terrors\ttime ms\tp50 us\tp90 us\tp99 us\tmax us\n";
+		for (auto const &[name, command]: totals.commands) {
+			uint64_t errors{ 0 };
+			for (uint64_t count: command.errors) {
+				errors += count;
+			}
+
+			snprintf(
+					line, sizeof(line),
+					"%s\t\t%" PRIu64 "\t%" PRIu64 "\t%.3f\t%.1f\t%.1f\t%.1f\t%.1f\n",
+					name.c_str(), command.calls, errors, command.time * scale / 1e3,
+					command.percentile(0.5) * scale, command.percentile(0.9) * scale,
+					command.percentile(0.99) * scale, command.max * scale);
+			result += line;
+
+			for (size_t i{ 1 }; i < errorKinds; i++) {
+				if (command.errors[i]) {
+					snprintf(
+							line, sizeof(line), "  %s: %" PRIu64 "\n", errorNames[i],
+							command.errors[i]);
+					result += line;
+				}
+			}
+		}
+
+		snprintf(
+				line, sizeof(line),
+				"io: %" PRIu64 " bytes read, %" PRIu64 " bytes written in %" PRIu64
+				" writes, %" PRIu64 " tokens\n",
+				io.bytesRead, io.bytesWritten, io.writes, io.tokens);
+		result += line;
+
+		return result;
+#endif
+	}
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "error.hpp"
+
+namespace commandIO {
+
+	/// \defgroup stats
+
+	using std::atomic;
+	using std::map;
+	using std::mutex;
+	using std::string;
+	using std::uint64_t;
+	using std::unique_ptr;
+	using std::unordered_map;
+
+	/*!
+	 * Time stamp counter.
+	 *
+	 * Reading the processor's time stamp counter is several times cheaper
+	 * than reading a clock, ticks are converted to nanoseconds when a report
+	 * is made.
+	 *
+	 * \ingroup stats
+	 *
+	 * \return Ticks.
+	 */
+	inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+#endif
+	}
+
+	/*!
+	 * Length of a tick.
+	 *
+	 * \ingroup stats
+	 *
+	 * \return Nanoseconds per tick.
+	 */
+	double tickNanoseconds();
+
+	/*!
+	 * Counter that is written by one thread and read by any thread.
+	 *
+	 * Updates are a relaxed load and store, there is no locked instruction
+	 * on the hot path.
+	 *
+	 * \ingroup stats
+	 */
+	class Tally {
+	public:
+		void add(uint64_t value) {
+			value_.store(
+					value_.load(std::memory_order_relaxed) + value,
+					std::memory_order_relaxed);
+		}
+
+		void max(uint64_t value) {
+			if (value > value_.load(std::memory_order_relaxed)) {
+				value_.store(value, std::memory_order_relaxed);
+			}
+		}
+
+		uint64_t get() const {
+			return value_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		atomic<uint64_t> value_{ 0 };
+	};
+
+	/*!
+	 * Latency histogram with buckets of about 12 % width.
+	 *
+	 * Values below 8 have their own bucket, larger values are split into 8
+	 * linear buckets per power of two.
+	 *
+	 * \ingroup stats
+	 */
+	struct Histogram {
+		static constexpr size_t size{ 8 * 62 };
+
+		static size_t bucket(uint64_t value) {
+			if (value < 8) {
+				return value;
+			}
+			int exponent{ 63 - __builtin_clzll(value) };
+			return (exponent - 2) * 8 + ((value >> (exponent - 3)) & 7);
+		}
+
+		// Largest value of bucket `index`.
+		static uint64_t upper(size_t index) {
+			if (index < 8) {
+				return index;
+			}
+			int shift{ int(index / 8) - 1 };
+			return ((8 + index % 8 + 1) << shift) - 1;
+		}
+
+		Tally counts[size];
+	};
+
+	// Error codes and failures without an error code.
+	size_t const errorKinds{ Error::UNKNOWN_COMMAND + 2 };
+
+	char const *const errorNames[errorKinds]{
+		"success", "excess parameter", "missing value", "invalid type",
+		"unknown parameter", "line too long", "out of range",
+		"trailing characters", "missing parameter", "unknown command", "other" };
+
+	/// Name under which commands that are not defined are counted.
+	inline constexpr char unknownCommand[]{ "(unknown)" };
+
+	/*!
+	 * Counters of one command.
+	 *
+	 * \ingroup stats
+	 */
+	struct CommandStats {
+		Tally calls;
+		Tally errors[errorKinds];
+		Tally time; ///< Ticks.
+		Tally max; ///< Ticks.
+		Histogram latency; ///< Ticks.
+	};
+
+	/*!
+	 * Input / output counters.
+	 *
+	 * \ingroup stats
+	 */
+	struct IOStats {
+		Tally bytesRead;
+		Tally bytesWritten;
+		Tally writes;
+		Tally tokens;
+	};
+
+	/*!
+	 * Counters of one thread.
+	 *
+	 * Only the owning thread updates the counters. New commands are added
+	 * under `access` so that readers can walk the table.
+	 *
+	 * \ingroup stats
+	 */
+	struct ThreadStats {
+		ThreadStats();
+		~ThreadStats();
+
+		CommandStats &command(char const *name) {
+			auto stats{ commands.find(name) };
+
+			if (stats != commands.end()) {
+				return *stats->second;
+			}
+			return add_(name);
+		}
+
+		IOStats io;
+		unordered_map<char const *, unique_ptr<CommandStats>> commands;
+		mutex access;
+		CommandStats *current{ nullptr }; ///< Command in progress.
+		uint64_t start; ///< Ticks.
+		Error error{ Error::SUCCESS }; ///< First error of the current command.
+		bool suspended{ false }; ///< Commands and tokens are not counted.
+
+	private:
+		CommandStats &add_(char const *);
+	};
+
+	/*!
+	 * Counters of one command summed over threads.
+	 *
+	 * \ingroup stats
+	 */
+	struct CommandTotals {
+		uint64_t calls{ 0 };
+		uint64_t errors[errorKinds]{};
+		uint64_t time{ 0 }; ///< Ticks.
+		uint64_t max{ 0 }; ///< Ticks.
+		uint64_t latency[Histogram::size]{}; ///< Ticks.
+
+		/*!
+		 * Add the counters of one thread.
+		 *
+		 * \param stats Counters.
+		 */
+		void add(CommandStats const &);
+
+		/*!
+		 * Latency percentile.
+		 *
+		 * \param q Quantile, e.g., 0.99.
+		 *
+		 * \return Latency in ticks below which a fraction `q` of the calls
+		 *   fall.
+		 */
+		uint64_t percentile(double) const;
+	};
+
+	/*!
+	 * Input / output counters summed over threads.
+	 *
+	 * \ingroup stats
+	 */
+	struct IOTotals {
+		uint64_t bytesRead{ 0 };
+		uint64_t bytesWritten{ 0 };
+		uint64_t writes{ 0 };
+		uint64_t tokens{ 0 };
+
+		/*!
+		 * Add the counters of one thread.
+		 *
+		 * \param stats Counters.
+		 */
+		void add(IOStats const &);
+	};
+
+	/*!
+	 * Statistics of all threads at one point in time.
+	 *
+	 * \ingroup stats
+	 */
+	struct Snapshot {
+		map<string, CommandTotals> commands;
+		IOTotals io;
+	};
+
+	/*!
+	 * Command and input / output statistics.
+	 *
+	 * All counters are thread local, reading them for a report is the only
+	 * operation that takes locks. Define `COMMANDIO_NO_STATS` to remove the
+	 * collection at compile time.
+	 *
+	 * \ingroup stats
+	 */
+	class Stats {
+	public:
+		/*!
+		 * Start timing a command.
+		 *
+		 * \param name Command name, the address identifies the command.
+		 */
+		static void begin([[maybe_unused]] char const *name) {
+#ifndef COMMANDIO_NO_STATS
+			ThreadStats &stats{ local_ };
+
+			if (stats.suspended) {
+				return;
+			}
+			stats.current = &stats.command(name);
+			stats.error = Error::SUCCESS;
+			stats.start = ticks();
+#endif
+		}
+
+		/*!
+		 * Record the error of the current command.
+		 *
+		 * \param error Error code.
+		 */
+		static void error([[maybe_unused]] Error error) {
+#ifndef COMMANDIO_NO_STATS
+			if (not local_.suspended and local_.error == Error::SUCCESS) {
+				local_.error = error;
+			}
+#endif
+		}
+
+		/*!
+		 * Stop timing a command.
+		 *
+		 * \param success Whether the command succeeded.
+		 */
+		static void end([[maybe_unused]] bool success) {
+#ifndef COMMANDIO_NO_STATS
+			ThreadStats &stats{ local_ };
+			CommandStats *command{ stats.current };
+
+			if (stats.suspended or not command) {
+				return;
+			}
+
+			uint64_t time{ ticks() - stats.start };
+
+			command->calls.add(1);
+			command->time.add(time);
+			command->max.max(time);
+			command->latency.counts[Histogram::bucket(time)].add(1);
+			if (not success) {
+				size_t kind(stats.error);
+				command->errors[kind ? kind : errorKinds - 1].add(1);
+			}
+			stats.current = nullptr;
+#endif
+		}
+
+		/*!
+		 * Command that is timed on the current thread.
+		 *
+		 * \return Counters of the command, `nullptr` if there is none.
+		 */
+		static CommandStats *current() {
+#ifndef COMMANDIO_NO_STATS
+			return local_.current;
+#else
+			return nullptr;
+#endif
+		}
+
+		/*!
+		 * Count a failure of a command that has ended, e.g., of a task that it
+		 * started. Call it on the thread that ran the command.
+		 *
+		 * \param command Counters of the command, see `current()`.
+		 */
+		static void fail([[maybe_unused]] CommandStats *command) {
+#ifndef COMMANDIO_NO_STATS
+			if (command) {
+				command->errors[errorKinds - 1].add(1);
+			}
+#endif
+		}
+
+		/*!
+		 * Count received input.
+		 *
+		 * \param size Number of bytes.
+		 */
+		static void read([[maybe_unused]] size_t size) {
+#ifndef COMMANDIO_NO_STATS
+			local_.io.bytesRead.add(size);
+#endif
+		}
+
+		/*!
+		 * Count a token that was parsed.
+		 */
+		static void token() {
+#ifndef COMMANDIO_NO_STATS
+			if (not local_.suspended) {
+				local_.io.tokens.add(1);
+			}
+#endif
+		}
+
+		/*!
+		 * Count a system call that wrote output.
+		 *
+		 * \param size Number of bytes written.
+		 */
+		static void write([[maybe_unused]] size_t size) {
+#ifndef COMMANDIO_NO_STATS
+			IOStats &io{ local_.io };
+			io.bytesWritten.add(size);
+			io.writes.add(1);
+#endif
+		}
+
+		/*!
+		 * Stop or resume counting commands and tokens on the current thread,
+		 * e.g., while a command is profiled. A command in progress is not
+		 * affected.
+		 *
+		 * \param suspended `true` to stop counting, `false` to resume.
+		 */
+		static void suspend([[maybe_unused]] bool suspended) {
+#ifndef COMMANDIO_NO_STATS
+			local_.suspended = suspended;
+#endif
+		}
+
+		/*!
+		 * Sum the counters of all threads, including threads that have ended.
+		 *
+		 * \return Statistics.
+		 */
+		static Snapshot snapshot();
+
+		/*!
+		 * Report of all threads, including threads that have ended.
+		 *
+		 * \return Report.
+		 */
+		static string report();
+
+	private:
+#ifndef COMMANDIO_NO_STATS
+		inline static thread_local ThreadStats local_;
+#endif
+	};
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "tuple.hpp"
+
+namespace commandIO {
+
+	using std::size_t;
+	using std::uint64_t;
+
+	/// \defgroup table
+
+	/*!
+	 * FNV-1a hash.
+	 *
+	 * \ingroup table
+	 *
+	 * \param data Data.
+	 * \param size Size of `data`.
+	 *
+	 * \return Hash value.
+	 */
+	constexpr uint64_t hash(char const *data, size_t size) {
+		uint64_t result{ 0xcbf29ce484222325 };
+
+		for (size_t i{ 0 }; i < size; i++) {
+			result = (result ^ static_cast<unsigned char>(data[i])) *
+					0x100000001b3;
+		}
+
+		return result;
+	}
+
+	/*!
+	 * Length of a C string.
+	 *
+	 * \ingroup table
+	 *
+	 * \param data C string.
+	 *
+	 * \return Length of `data`.
+	 */
+	constexpr size_t length(char const *data) {
+		size_t result{ 0 };
+
+		while (data[result]) {
+			result++;
+		}
+
+		return result;
+	}
+
+	/*!
+	 * Open addressing hash table that maps command names to their position in
+	 * a list of function definitions.
+	 *
+	 * \ingroup table
+	 *
+	 * \tparam N Number of function definitions.
+	 */
+	template <size_t N>
+	class Table {
+	public:
+		/*!
+		 * Constructor.
+		 *
+		 * \param defs Function definitions.
+		 */
+		template <class D>
+		constexpr Table(D const &defs) {
+			add_(defs, 0);
+		}
+
+		/*!
+		 * Find a command.
+		 *
+		 * \param name Command name.
+		 * \param size Size of `name`.
+		 *
+		 * \return Position of the command, `N` if it was not found.
+		 */
+		constexpr size_t find(char const *name, size_t size) const {
+			uint64_t key{ hash(name, size) };
+
+			for (size_t i{ key & mask_ }; slots_[i]; i = (i + 1) & mask_) {
+				size_t index{ slots_[i] - 1 };
+
+				if (
+						hashes_[index] == key and sizes_[index] == size and
+						equal_(names_[index], name, size)) {
+					return index;
+				}
+			}
+
+			return N;
+		}
+
+	private:
+		static constexpr size_t buckets_() {
+			size_t result{ 1 };
+
+			while (result < 2 * N) {
+				result <<= 1;
+			}
+
+			return result;
+		}
+
+		static constexpr bool equal_(char const *a, char const *b, size_t size) {
+			for (size_t i{ 0 }; i < size; i++) {
+				if (a[i] != b[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr void add_(EmptyC, size_t) {}
+
+		template <class H, class... Tail>
+		constexpr void add_(Tuple<H, Tail...> const &defs, size_t index) {
+			char const *name{ defs.head.tail.head };
+			size_t size{ length(name) };
+
+			// The first definition of a name takes precedence.
+			if (find(name, size) == N) {
+				names_[index] = name;
+				sizes_[index] = size;
+				hashes_[index] = hash(name, size);
+
+				size_t i{ hashes_[index] & mask_ };
+				while (slots_[i]) {
+					i = (i + 1) & mask_;
+				}
+				slots_[i] = index + 1;
+			}
+
+			add_(defs.tail, index + 1);
+		}
+
+		static constexpr size_t mask_{ buckets_() - 1 };
+
+		std::array<char const *, N> names_{};
+		std::array<size_t, N> sizes_{};
+		std::array<uint64_t, N> hashes_{};
+		std::array<size_t, mask_ + 1> slots_{}; ///< Position + 1, 0 if empty.
+	};
+}
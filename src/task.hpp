@@ -0,0 +1,257 @@
+#pragma once
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#define COMMANDIO_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <sys/epoll.h>
+#include <type_traits>
+#include <utility>
+
+#include "print.hpp"
+#include "reactor.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+namespace commandIO {
+
+	/// \defgroup task
+
+	using std::coroutine_handle;
+	using std::string;
+
+	template <class T>
+	class Task;
+
+	// Storage for the result of a task.
+	template <class T>
+	struct Result_ {
+		void return_value(T result) {
+			value = std::move(result);
+		}
+
+		T get() {
+			return std::move(*value);
+		}
+
+		std::optional<T> value;
+	};
+
+	template <>
+	struct Result_<void> {
+		void return_void() {}
+
+		void get() {}
+	};
+
+	/**
+	 * Coroutine that produces a value of type `T`.
+	 *
+	 * A task starts when it is awaited. A command that returns a task is
+	 * started by the interface, it is suspended while it waits for a file
+	 * descriptor or timer and its value is printed once it completes. Task
+	 * commands must take their parameters by value. Class member functions
+	 * may return tasks as well, their instance is not locked while the task
+	 * runs.
+	 *
+	 * \ingroup task
+	 *
+	 * \tparam T Value type.
+	 */
+	template <class T>
+	class Task {
+	public:
+		struct promise_type : Result_<T> {
+			struct Final_ {
+				bool await_ready() noexcept {
+					return false;
+				}
+
+				coroutine_handle<> await_suspend(
+						coroutine_handle<promise_type> handle) noexcept {
+					return handle.promise().continuation;
+				}
+
+				void await_resume() noexcept {}
+			};
+
+			Task get_return_object() {
+				return Task{ coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_always initial_suspend() noexcept {
+				return {};
+			}
+
+			Final_ final_suspend() noexcept {
+				return {};
+			}
+
+			void unhandled_exception() {
+				exception = std::current_exception();
+			}
+
+			coroutine_handle<> continuation{ std::noop_coroutine() };
+			std::exception_ptr exception;
+		};
+
+		Task() {}
+
+		Task(Task &&other) : handle_{ std::exchange(other.handle_, nullptr) } {}
+
+		~Task() {
+			if (handle_) {
+				handle_.destroy();
+			}
+		}
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		coroutine_handle<> await_suspend(coroutine_handle<> continuation) {
+			handle_.promise().continuation = continuation;
+			return handle_;
+		}
+
+		T await_resume() {
+			if (handle_.promise().exception) {
+				std::rethrow_exception(handle_.promise().exception);
+			}
+			return handle_.promise().get();
+		}
+
+	private:
+		explicit Task(coroutine_handle<promise_type> handle) : handle_{ handle } {}
+
+		coroutine_handle<promise_type> handle_;
+	};
+
+	// Coroutine that runs to completion on its own.
+	struct Detached_ {
+		struct promise_type {
+			Detached_ get_return_object() {
+				return {};
+			}
+
+			std::suspend_never initial_suspend() noexcept {
+				return {};
+			}
+
+			std::suspend_never final_suspend() noexcept {
+				return {};
+			}
+
+			void return_void() {}
+
+			// `spawn_()` catches the exceptions of tasks, this is not reached.
+			void unhandled_exception() {
+				std::terminate();
+			}
+		};
+	};
+
+	// Suspend until the reactor calls back.
+	struct Event_ {
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		void await_suspend(coroutine_handle<> handle) {
+			if (fd == -1) {
+				Reactor::local().after(delay, [handle]() { handle.resume(); });
+			} else {
+				Reactor::local().watch(fd, events, [handle]() { handle.resume(); });
+			}
+		}
+
+		void await_resume() const noexcept {}
+
+		int fd;
+		uint32_t events;
+		Clock::duration delay;
+	};
+
+	/**
+	 * Wait until a file descriptor is readable.
+	 *
+	 * \ingroup task
+	 *
+	 * \param fd File descriptor.
+	 *
+	 * \return Awaitable.
+	 */
+	inline Event_ readable(int fd) {
+		return { fd, EPOLLIN, {} };
+	}
+
+	/**
+	 * Wait until a file descriptor is writable.
+	 *
+	 * \ingroup task
+	 *
+	 * \param fd File descriptor.
+	 *
+	 * \return Awaitable.
+	 */
+	inline Event_ writable(int fd) {
+		return { fd, EPOLLOUT, {} };
+	}
+
+	/**
+	 * Wait for some time.
+	 *
+	 * \ingroup task
+	 *
+	 * \param delay Delay.
+	 *
+	 * \return Awaitable.
+	 */
+	inline Event_ sleep(Clock::duration delay) {
+		return { -1, 0, delay };
+	}
+
+	/*
+	 * Run a task started by a command and print its value. An exception
+	 * thrown by the task is reported and counted as a failure of the
+	 * command.
+	 *
+	 * The number of tasks in flight is kept in `io.tasks`, an input / output
+	 * object must not be destroyed before all of its tasks have completed.
+	 */
+	template <class I, class T>
+	Detached_ spawn_(I &io, Task<T> task) {
+		CommandStats *command{ Stats::current() };
+
+		io.tasks++;
+		try {
+			if constexpr (std::is_void_v<T>) {
+				co_await task;
+			} else {
+				print(io, co_await task, "\n");
+			}
+		} catch (std::exception const &exception) {
+			print(io, "Task failed: ", exception.what(), "\n");
+			Stats::fail(command);
+		} catch (...) {
+			print(io, "Task failed.\n");
+			Stats::fail(command);
+		}
+		io.tasks--;
+	}
+
+	template <class T>
+	string typeOf(Task<T> &) {
+		std::decay_t<T> data{};
+		return typeOf(data);
+	}
+
+	// A task without a value returns nothing.
+	template <class I, class... FArgs>
+	void returnType(I &, Task<void> (*)(FArgs...)) {}
+}
+
+#endif
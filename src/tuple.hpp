@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace commandIO {
 
 	/*! Tuple.
@@ -15,10 +17,28 @@ namespace commandIO {
 	// Full definition.
 	template <class H, class... Tail>
 	struct Tuple<H, Tail...> {
-		H head; //< First element.
-		Tuple<Tail...> tail; //< Remaining elements.
+		H head; ///< First element.
+		Tuple<Tail...> tail; ///< Remaining elements.
 	};
 
+	/**
+	 * Element of a tuple.
+	 *
+	 * \tparam N Position.
+	 *
+	 * \param t Tuple.
+	 *
+	 * \return Element `N` of `t`.
+	 */
+	template <std::size_t N, class H, class... Tail>
+	constexpr auto const &get(Tuple<H, Tail...> const &t) {
+		if constexpr (N == 0) {
+			return t.head;
+		} else {
+			return get<N - 1>(t.tail);
+		}
+	}
+
 	inline void fill(Empty) {}
 
 	template <class H, class... Tail>
@@ -34,21 +54,22 @@ namespace commandIO {
 	 *
 	 * \return Tuple containing `args`.
 	 */
-	template <class... Args>
-	Tuple<Args...> pack(Args... args) {
-		Tuple<Args...> t;
-		fill(t, args...);
+	constexpr Tuple<> pack() {
+		return {};
+	}
 
-		return t;
+	template <class H, class... Tail>
+	constexpr Tuple<H, Tail...> pack(H head, Tail... tail) {
+		return { head, pack(tail...) };
 	}
 
 	template <class... Args>
-	Tuple<Args...> param(Args... args) {
+	constexpr Tuple<Args...> param(Args... args) {
 		return pack(args...);
 	}
 
 	template <class... Args>
-	Tuple<Args...> func(Args... args) {
+	constexpr Tuple<Args...> func(Args... args) {
 		return pack(args...);
 	}
 }
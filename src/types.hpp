@@ -1,13 +1,34 @@
 #pragma once
 
+#include <charconv>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "error.hpp"
+#include "output.hpp"
+
 namespace commandIO {
 
+	using std::errc;
+	using std::from_chars;
+	using std::from_chars_result;
+	using std::is_floating_point_v;
+	using std::is_integral_v;
+	using std::is_same_v;
+	using std::is_unsigned_v;
 	using std::istringstream;
+	using std::numeric_limits;
 	using std::string;
+	using std::string_view;
 	using std::vector;
 
 	/*
@@ -78,39 +99,178 @@ namespace commandIO {
 		return "string";
 	}
 
+	inline string typeOf(string_view) {
+		return "string";
+	}
+
+#ifdef __cpp_lib_span
+	inline string typeOf(std::span<char const>) {
+		return "string";
+	}
+#endif
+
+	inline string typeOf(FileRegion) {
+		return "file";
+	}
+
 	template <class T>
 	string typeOf(vector<T> &) {
 		T data{};
 		return "vector<" + typeOf(data) + ">";
 	}
 
+	// Convert a string to an integer, accepting `0x` and `0b` prefixes.
+	template <class T>
+	Error convertInteger_(T *data, string_view s) {
+		char const *first{ s.data() };
+		char const *last{ first + s.size() };
+		bool negative{ false };
+		int base{ 10 };
+
+		if (first != last and (*first == '-' or *first == '+')) {
+			negative = *first == '-';
+			first++;
+		}
+		if (last - first > 2 and first[0] == '0') {
+			if (first[1] == 'x' or first[1] == 'X') {
+				base = 16;
+				first += 2;
+			} else if (first[1] == 'b' or first[1] == 'B') {
+				base = 2;
+				first += 2;
+			}
+		}
+
+		unsigned long long magnitude;
+		from_chars_result result{ from_chars(first, last, magnitude, base) };
+
+		if (result.ec == errc::invalid_argument) {
+			return Error::INVALID_PARAM_TYPE;
+		}
+		if (result.ptr != last) {
+			return Error::TRAILING_CHARACTERS;
+		}
+		if (result.ec == errc::result_out_of_range) {
+			return Error::OUT_OF_RANGE;
+		}
+
+		unsigned long long max{ static_cast<unsigned long long>(
+				numeric_limits<T>::max()) };
+
+		if (negative) {
+			if (not magnitude) {
+				*data = 0;
+				return Error::SUCCESS;
+			}
+			if constexpr (is_unsigned_v<T>) {
+				return Error::OUT_OF_RANGE;
+			} else {
+				if (magnitude - 1 > max) {
+					return Error::OUT_OF_RANGE;
+				}
+				*data = -static_cast<T>(magnitude - 1) - 1;
+				return Error::SUCCESS;
+			}
+		}
+
+		if (magnitude > max) {
+			return Error::OUT_OF_RANGE;
+		}
+		*data = static_cast<T>(magnitude);
+
+		return Error::SUCCESS;
+	}
+
+	// Convert a string to a floating point number.
+	template <class T>
+	Error convertFloat_(T *data, string_view s) {
+		char const *first{ s.data() };
+		char const *last{ first + s.size() };
+
+		if (last - first > 1 and *first == '+' and first[1] != '-') {
+			first++;
+		}
+
+		from_chars_result result{ from_chars(first, last, *data) };
+
+		if (result.ec == errc::invalid_argument) {
+			return Error::INVALID_PARAM_TYPE;
+		}
+		if (result.ptr != last) {
+			return Error::TRAILING_CHARACTERS;
+		}
+		if (result.ec == errc::result_out_of_range) {
+			return Error::OUT_OF_RANGE;
+		}
+
+		return Error::SUCCESS;
+	}
+
 	/**
 	 * Convert a string to any type.
 	 *
+	 * Arithmetic types are converted with `from_chars()`, the whole string
+	 * must be consumed. Integers may have a `0x` or `0b` prefix, booleans are
+	 * written as `0`, `1`, `false` or `true` and character types take a
+	 * single character. Other types are read with `operator>>`. A string is
+	 * only allocated when the target type is `string`.
+	 *
 	 * \param data Result of the conversion.
 	 * \param s Input of the conversion.
 	 *
-	 * \return `true` if the conversion was successful, `false` otherwise.
+	 * \return success on success, an error code otherwise.
 	 */
-	inline bool convert(string *data, string s) {
+	inline Error convert(string *data, string_view s) {
 		*data = s;
 
-		return true;
+		return Error::SUCCESS;
 	}
 
 	template <class T>
-	bool convert(T *data, string s) {
-		istringstream iss(s);
+	Error convert(T *data, string_view s) {
+		if constexpr (is_same_v<T, bool>) {
+			if (s == "1" or s == "true") {
+				*data = true;
+			} else if (s == "0" or s == "false") {
+				*data = false;
+			} else {
+				return Error::INVALID_PARAM_TYPE;
+			}
+			return Error::SUCCESS;
+		} else if constexpr (
+				is_same_v<T, char> or is_same_v<T, signed char> or
+				is_same_v<T, unsigned char>) {
+			if (s.empty()) {
+				return Error::INVALID_PARAM_TYPE;
+			}
+			if (s.size() > 1) {
+				return Error::TRAILING_CHARACTERS;
+			}
+			*data = static_cast<T>(s[0]);
+			return Error::SUCCESS;
+		} else if constexpr (is_integral_v<T>) {
+			return convertInteger_(data, s);
+		} else if constexpr (is_floating_point_v<T>) {
+			return convertFloat_(data, s);
+		} else {
+			istringstream iss{ string(s) };
 
-		iss >> *data;
+			iss >> *data;
 
-		return not iss.fail();
+			if (iss.fail()) {
+				return Error::INVALID_PARAM_TYPE;
+			}
+			if (iss.peek() != istringstream::traits_type::eof()) {
+				return Error::TRAILING_CHARACTERS;
+			}
+			return Error::SUCCESS;
+		}
 	}
 
 	template <class T>
-	bool convert(vector<T> *data, string s) {
-		T value;
-		bool status{ convert(&value, s) };
+	Error convert(vector<T> *data, string_view s) {
+		T value{};
+		Error status{ convert(&value, s) };
 		data->push_back(value);
 
 		return status;
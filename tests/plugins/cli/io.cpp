@@ -27,7 +27,7 @@ void _CLiIO::prepare(int argc, char** argv) {
  *
  * @return A string.
  */
-string _CLiIO::read(void) {
+string_view _CLiIO::read(void) {
 	_number++;
 
 	return _argv[_number];
@@ -48,6 +48,15 @@ CliIO::CliIO(int argc, char** argv) {
 	_CIO.prepare(argc, argv);
 }
 
+/**
+ * Check whether more input is available.
+ *
+ * @return `1` if more input is available, `0` otherwise.
+ */
+size_t CliIO::available(void) {
+	return not _CIO.eol();
+}
+
 /**
  * Check whether a line ending was encountered.
  *
@@ -62,10 +71,21 @@ bool CliIO::eol(void) {
  *
  * @return String.
  */
-string CliIO::read(void) {
+string_view CliIO::read(void) {
 	return _CIO.read();
 }
 
+/**
+ * Write data.
+ *
+ * @param data Data.
+ * @param size Size of `data`.
+ */
+void CliIO::write(char const* data, size_t size) {
+	string s(data, size);
+	_CIO.write(s);
+}
+
 /**
  * Write one string.
  *
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 using std::string;
+using std::string_view;
 
 /**
  * User input and output.
@@ -12,7 +14,7 @@ class _CLiIO {
 		_CLiIO(void) {}
 		bool eol(void);
 		void prepare(int, char**);
-		string read(void);
+		string_view read(void);
 		void write(string&);
 		string output;
 	private:
@@ -27,10 +29,16 @@ class _CLiIO {
 class CliIO {
 	public:
 		CliIO(int, char**);
+		size_t available(void);
+		bool wait(void) {
+			return false;
+		}
 		bool eol(void);
 		void flush(void) {}
-		string read(void);
+		string_view read(void);
+		void write(char const*, size_t);
 		void write(string&);
+		void endCommand(bool) {}
 		bool interactive = false;
 };
 
@@ -9,6 +9,15 @@ bool _ReplIO::eol(void) {
 	return _endOfLine || _number >= _argc - 1; // || needed?
 }
 
+/**
+ * Check whether more input is available.
+ *
+ * @return `1` if more input is available, `0` otherwise.
+ */
+size_t _ReplIO::available(void) {
+	return _number < _argc - 1;
+}
+
 /**
  * Prepare data.
  *
@@ -28,8 +37,8 @@ void _ReplIO::prepare(int argc, char** argv) {
  *
  * @return A string.
  */
-string _ReplIO::read(void) {
-	string s;
+string_view _ReplIO::read(void) {
+	string_view s;
 	int i;
 
 	_number++;
@@ -48,7 +57,7 @@ string _ReplIO::read(void) {
 		return s.substr(0, i);
 	}
 
-	return _argv[_number];
+	return s;
 }
 
 /*
@@ -59,6 +68,15 @@ void _ReplIO::write(string& data) {
 }
 
 
+/**
+ * Check whether more input is available.
+ *
+ * @return `1` if more input is available, `0` otherwise.
+ */
+size_t ReplIO::available(void) {
+	return _RIO.available();
+}
+
 /**
  * Check whether a line ending was encountered.
  *
@@ -73,10 +91,21 @@ bool ReplIO::eol(void) {
  *
  * @return String.
  */
-string ReplIO::read(void) {
+string_view ReplIO::read(void) {
 	return _RIO.read();
 }
 
+/**
+ * Write data.
+ *
+ * @param data Data.
+ * @param size Size of `data`.
+ */
+void ReplIO::write(char const* data, size_t size) {
+	string s(data, size);
+	_RIO.write(s);
+}
+
 /**
  * Write one string.
  *
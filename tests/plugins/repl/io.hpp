@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 using std::string;
+using std::string_view;
 
 /**
  * User input and output.
@@ -10,9 +12,10 @@ using std::string;
 class _ReplIO {
 	public:
 		_ReplIO(void) {}
+		size_t available(void);
 		bool eol(void);
 		void prepare(int, char**);
-		string read(void);
+		string_view read(void);
 		void write(string&);
 		string output;
 	private:
@@ -28,10 +31,16 @@ class _ReplIO {
 class ReplIO {
 	public:
 		ReplIO(void) {}
+		size_t available(void);
+		bool wait(void) {
+			return false;
+		}
 		bool eol(void);
 		void flush(void) {}
-		string read(void);
+		string_view read(void);
+		void write(char const*, size_t);
 		void write(string&);
+		void endCommand(bool) {}
 		bool interactive = true;
 };
 
@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eval.hpp"
+#include "output.hpp"
+#include "print.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+struct TokenIO {
+	TokenIO(vector<string> tokens) : tokens{ tokens } {}
+
+	void reset(vector<string> tokens) {
+		this->tokens = tokens;
+		token = 0;
+		output.clear();
+	}
+
+	bool eol() const {
+		return token == tokens.size();
+	}
+
+	void flush() {
+		token = tokens.size();
+	}
+
+	string_view read() {
+		return tokens[token++];
+	}
+
+	void write(char const *data, size_t size) {
+		output.append(data, size);
+	}
+
+	vector<string> tokens;
+	size_t token{ 0 };
+	string output;
+	Format format;
+	Session session;
+};
+
+size_t total(string &&s, string const &t, vector<int> const &v) {
+	return v.size() + s.size() + t.size();
+}
+
+void append(string &s, vector<int> v) {
+	s += std::to_string(v.size());
+}
+
+class Store {
+public:
+	void add(vector<int> &&v) {
+		data_ = std::move(v);
+	}
+
+	string const &name(int const &i) {
+		name_ = std::to_string(i + data_.size());
+		return name_;
+	}
+
+	size_t size() const {
+		return data_.size();
+	}
+
+private:
+	vector<int> data_;
+	string name_;
+};
+
+class Counter {
+public:
+	void increase() {
+		value_++;
+	}
+
+	int value() const {
+		return value_;
+	}
+
+private:
+	int value_{ 0 };
+};
+
+TEST_CASE("Reference parameters", "[eval]") {
+	TokenIO io({ "abc", "-t", "de", "1", "2", "3" });
+	auto defs{ pack(
+			param("s", "string"), param("-t", "x", "string"),
+			param("v", "vector")) };
+
+	REQUIRE(parse(io, total, defs));
+	REQUIRE(io.output == "8\n");
+}
+
+TEST_CASE("Lvalue reference parameters", "[eval]") {
+	TokenIO io({ "x", "1", "2" });
+	auto defs{ pack(param("s", "string"), param("v", "vector")) };
+
+	REQUIRE(parse(io, append, defs));
+	REQUIRE(io.output == "");
+}
+
+TEST_CASE("Member function reference parameters", "[eval]") {
+	Store store;
+	TokenIO io({ "1", "2", "3" });
+	auto add{ pack(&store, &Store::add) };
+	auto name{ pack(&store, &Store::name) };
+	auto defs{ pack(param("v", "vector")) };
+
+	REQUIRE(parse(io, add, defs));
+
+	io.reset({ "4" });
+	REQUIRE(parse(io, name, defs));
+	REQUIRE(io.output == "7\n");
+}
+
+TEST_CASE("Session objects", "[eval]") {
+	Store store;
+	TokenIO first({ "1", "2", "3" });
+	TokenIO second({ "1" });
+	auto add{ pack(factory<Store>(), &Store::add) };
+	auto name{ pack(factory<Store>(), &Store::name) };
+	auto sharedAdd{ pack(shared(&store), &Store::add) };
+	auto sharedName{ pack(shared(&store), &Store::name) };
+	auto defs{ pack(param("v", "vector")) };
+
+	REQUIRE(parse(first, add, defs));
+	REQUIRE(parse(second, add, defs));
+
+	first.reset({ "0" });
+	REQUIRE(parse(first, name, defs));
+	REQUIRE(first.output == "3\n");
+	second.reset({ "0" });
+	REQUIRE(parse(second, name, defs));
+	REQUIRE(second.output == "1\n");
+
+	first.reset({ "1", "2" });
+	REQUIRE(parse(first, sharedAdd, defs));
+	second.reset({ "0" });
+	REQUIRE(parse(second, sharedName, defs));
+	REQUIRE(second.output == "2\n");
+}
+
+TEST_CASE("Const member functions", "[eval]") {
+	Store store;
+	TokenIO io({ "1", "2" });
+	auto defs{ pack(param("v", "vector")) };
+	auto none{ pack() };
+
+	REQUIRE(parse(io, pack(&store, &Store::add), defs));
+
+	io.reset({});
+	REQUIRE(parse(io, pack(&store, &Store::size), none));
+	REQUIRE(io.output == "2\n");
+
+	io.reset({});
+	shared_mutex mutex;
+	REQUIRE(parse(io, pack(reading(&store, mutex), &Store::size), none));
+	REQUIRE(io.output == "2\n");
+}
+
+TEST_CASE("Shared instance locking", "[eval]") {
+	Counter counter;
+	shared_mutex mutex;
+	vector<std::thread> threads;
+	auto none{ pack() };
+
+	concurrent();
+	for (int i{ 0 }; i < 4; i++) {
+		threads.emplace_back([&]() {
+			TokenIO io({});
+			for (int j{ 0 }; j < 10000; j++) {
+				parse(io, pack(shared(&counter, mutex), &Counter::increase),
+					none);
+				parse(io, pack(shared(&counter, mutex), &Counter::value), none);
+			}
+		});
+	}
+	for (std::thread &thread: threads) {
+		thread.join();
+	}
+
+	REQUIRE(counter.value() == 40000);
+}
+
+TEST_CASE("Instances have their own locks", "[eval]") {
+	Counter held;
+	Counter counter;
+	shared_mutex heldMutex;
+	shared_mutex mutex;
+	TokenIO io({});
+	auto none{ pack() };
+
+	concurrent();
+	Lock lock{ acquire(io, shared(&held, heldMutex), false) };
+	for (int i{ 0 }; i < 100; i++) {
+		REQUIRE(parse(io, pack(shared(&counter, mutex), &Counter::increase),
+			none));
+	}
+	REQUIRE(counter.value() == 100);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "interface.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+int hookInc(int a) {
+	return a + 1;
+}
+
+void hookNothing() {}
+
+// Records every hook, negative values are rejected.
+struct Trace : NoHooks {
+	static constexpr bool timed{ true };
+
+	inline static vector<string> events;
+
+	static void onToken(string_view token) {
+		events.push_back("token " + string(token));
+	}
+
+	template <class A>
+	static bool beforeCall(char const *name, A const &) {
+		events.push_back(string("before ") + name);
+		return true;
+	}
+
+	static bool beforeCall(char const *name, Tuple<int> const &argv) {
+		events.push_back(string("before ") + name);
+		return argv.head >= 0;
+	}
+
+	template <class R>
+	static void afterCall(char const *name, R const &result, uint64_t) {
+		if constexpr (std::is_same_v<R, Void>) {
+			events.push_back(string("after ") + name);
+		} else {
+			events.push_back(
+				string("after ") + name + " " + std::to_string(result));
+		}
+	}
+
+	static void onError(Error error) {
+		events.push_back("error " + std::to_string(error));
+	}
+};
+
+TEST_CASE("Hook policy", "[hooks]") {
+	auto commands{ hookedInterface<Trace>(
+		func(hookInc, "hookInc", "Increment a value.", param("a", "value")),
+		func(hookNothing, "hookNothing", "Do nothing.")) };
+
+	Trace::events.clear();
+
+	SECTION("Commands") {
+		MemoryIO io({
+			{ "hookInc", "1" }, { "hookInc", "x" }, { "hookInc", "-1" },
+			{ "hookNothing" }, { "hookInc" }, { "hookUndefined" } });
+		commands.run(io);
+
+		REQUIRE(
+			Trace::events ==
+			vector<string>{
+				"token 1", "before hookInc", "after hookInc 2", "token x",
+				"error 3", "token -1", "before hookInc", "before hookNothing",
+				"after hookNothing", "error 8", "error 9" });
+		REQUIRE(io.output.substr(0, 2) == "2\n");
+	}
+
+	SECTION("Map") {
+		MemoryIO io({
+			{ "map", "hookInc", "2", "3" }, { "map", "hookInc", "4", "-5" },
+			{ "map", "hookUndefined" } });
+		commands.run(io);
+
+		REQUIRE(
+			Trace::events ==
+			vector<string>{
+				"token 2", "token 3", "before hookInc", "before hookInc",
+				"after hookInc 3", "after hookInc 4", "token 4", "token -5",
+				"before hookInc", "before hookInc", "error 9" });
+		REQUIRE(io.output.substr(0, 4) == "3\n4\n");
+	}
+
+	SECTION("Single function") {
+		MemoryIO io({ { "7" } });
+		io.available();
+		commandInterface<Trace>(
+			io, hookInc, "inc", "Increment a value.", param("a", "value"));
+
+		REQUIRE(
+			Trace::events ==
+			vector<string>{ "token 7", "before inc", "after inc 8" });
+	}
+}
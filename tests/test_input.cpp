@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fcntl.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "input.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+/*
+ * Feed `data` through a pipe in random sized chunks and collect all lines.
+ */
+vector<vector<string>> tokenize(
+		string const &data, Kernel kernel, size_t maxLine, unsigned seed) {
+	InputBuffer input(maxLine, kernel);
+	vector<vector<string>> lines;
+	std::mt19937 random(seed);
+	int fds[2];
+	size_t offset{ 0 };
+	bool open{ true };
+
+	REQUIRE(pipe(fds) == 0);
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+	while (open) {
+		if (offset < data.size()) {
+			size_t size{ std::min(data.size() - offset, size_t(random() % 200)) };
+			REQUIRE(write(fds[1], data.data() + offset, size) == ssize_t(size));
+			offset += size;
+			if (offset == data.size()) {
+				close(fds[1]);
+			}
+		}
+
+		open = input.receive(fds[0]);
+		while (input.next()) {
+			vector<string> tokens;
+			while (not input.eol()) {
+				tokens.emplace_back(input.read());
+			}
+			lines.push_back(tokens);
+		}
+		if (input.overflow()) {
+			lines.push_back({ "<overflow>" });
+		}
+	}
+	close(fds[0]);
+
+	return lines;
+}
+
+TEST_CASE("Tokenizer", "[input]") {
+	vector<vector<string>> expected{
+		{ "add", "1", "2" }, { "greet", "Dan the man" }, { "a b", "c\nd" },
+		{ "x\"y" }, { "last" } };
+
+	for (Kernel kernel: { Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2 }) {
+		REQUIRE(
+				tokenize(
+						"add 1 2\n\n greet \"Dan the man\"\t\na\\ b c\\\nd\nx\\\"y\nlast",
+						kernel, 0, 0) == expected);
+	}
+}
+
+TEST_CASE("Tokenizer overflow", "[input]") {
+	vector<vector<string>> expected{
+		{ "add", "1" }, { "<overflow>" }, { "add", "2" } };
+
+	for (Kernel kernel: { Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2 }) {
+		REQUIRE(
+				tokenize(
+						"add 1\nadd " + string(100, '1') + "\nadd 2\n", kernel, 10, 0) ==
+				expected);
+	}
+}
+
+TEST_CASE("Tokenizer differential", "[input]") {
+	char const alphabet[]{ "ab12  \t\t\n\"\\" };
+	std::mt19937 random(42);
+
+	for (int i{ 0 }; i < 200; i++) {
+		string data;
+		size_t size{ random() % 2000 };
+		bool plain{ i % 2 == 0 };
+
+		for (size_t j{ 0 }; j < size; j++) {
+			data += alphabet[random() % (sizeof(alphabet) - (plain ? 3 : 1))];
+		}
+
+		for (size_t maxLine: { 0, 40 }) {
+			vector<vector<string>> expected{
+				tokenize(data, Kernel::SCALAR, maxLine, i) };
+
+			REQUIRE(tokenize(data, Kernel::SSE2, maxLine, i) == expected);
+			REQUIRE(tokenize(data, Kernel::AVX2, maxLine, i) == expected);
+		}
+	}
+}
+
+TEST_CASE("Tokenizer memory", "[input]") {
+	string padding(40, ' ');
+	vector<vector<string>> expected{
+		{ "add", "1" }, { "a\nb" }, { "c" }, { "last" } };
+	vector<size_t> numbers{ 1, 4, 7, 8 };
+
+	for (Kernel kernel: { Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2 }) {
+		string data{
+			"add 1" + padding + "\n\n\na\\\nb\n" + padding + "\nc\nlast" };
+		InputBuffer input(0, kernel);
+		vector<vector<string>> lines;
+		vector<size_t> lineNumbers;
+
+		bool open{ true };
+
+		input.assign(data.data(), data.size());
+		while (open) {
+			open = input.receive();
+			while (input.next()) {
+				vector<string> tokens;
+				while (not input.eol()) {
+					tokens.emplace_back(input.read());
+				}
+				lines.push_back(tokens);
+				lineNumbers.push_back(input.line());
+			}
+		}
+
+		REQUIRE(lines == expected);
+		REQUIRE(lineNumbers == numbers);
+	}
+}
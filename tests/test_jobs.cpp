@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "interface.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+int add(vector<int> v) {
+	int sum{ 0 };
+	for (int element: v) {
+		sum += element;
+	}
+	return sum;
+}
+
+class Log {
+public:
+	void push(int value) {
+		text += std::to_string(value);
+	}
+
+	string show() const {
+		return text;
+	}
+
+private:
+	string text;
+};
+
+TEST_CASE("Jobs", "[jobs]") {
+	ThreadPool pool(2);
+	Jobs jobs(pool);
+	std::atomic<bool> go{ false };
+	string output;
+
+	size_t first{ jobs.start("first", [&](string &output) {
+		while (not go) {}
+		output = "1";
+		return true;
+	}) };
+	size_t second{ jobs.start("second", [](string &) { return false; }) };
+
+	REQUIRE(first == 1);
+	REQUIRE(second == 2);
+	REQUIRE(jobs.wait(second) == Status::FAILED);
+	REQUIRE(jobs.result(first, output) == Status::RUNNING);
+	REQUIRE(jobs.list() == "[1] running\tfirst\n[2] failed\tsecond\n");
+	REQUIRE(jobs.running() == 1);
+
+	go = true;
+	REQUIRE(jobs.wait(first) == Status::DONE);
+	REQUIRE(jobs.running() == 0);
+	REQUIRE(jobs.result(first, output) == Status::DONE);
+	REQUIRE(output == "1");
+	REQUIRE(jobs.result(first, output) == Status::UNKNOWN);
+	REQUIRE(jobs.wait(3) == Status::UNKNOWN);
+}
+
+TEST_CASE("Background commands", "[jobs]") {
+	MemoryIO io({
+		{ "add", "1", "2", "&" }, { "bg", "add", "3", "4" }, { "wait", "1" },
+		{ "wait", "2" }, { "result", "2" }, { "result", "1" }, { "bg" } });
+	Interface commands(
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+
+	commands.run(io);
+	REQUIRE(io.output == "[1]\n[2]\n[1] done\n[2] done\n7\n3\nMissing command.\n");
+}
+
+TEST_CASE("Batch commands", "[jobs]") {
+	Log log;
+	MemoryIO io({
+		{ "push", "1" }, { "add", "1", "2" }, { "push", "2" }, { "nop" },
+		{ "push", "3" }, { "show" }, { "barrier" }, { "add", "3", "4" },
+		{ "exit" }, { "add", "5" } });
+	Interface commands(
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")),
+		func(pack(&log, &Log::push), "push", "Append a value.",
+			param("value", "value")),
+		func(pack(&log, &Log::show), "show", "Show the log."));
+
+	commands.batch(io);
+	REQUIRE(io.output.substr(0, 28) == "3\nUnknown command: nop\nAvail");
+	REQUIRE(io.output.substr(io.output.size() - 6) == "123\n7\n");
+}
+
+TEST_CASE("Built in commands in a batch", "[jobs]") {
+	MemoryIO io({
+		{ "map", "add", "1", "2" }, { "bg", "add", "1" }, { "wait", "1" },
+		{ "add", "3", "4", "&" } });
+	Interface commands(
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+
+	commands.batch(io);
+	REQUIRE(
+		io.output ==
+		"1\n2\n"
+		"Job control is not available here.\n"
+		"Job control is not available here.\n"
+		"Job control is not available here.\n");
+}
+
+TEST_CASE("Built in commands on an instance in a batch", "[jobs]") {
+	Log log;
+	MemoryIO io({
+		{ "map", "push", "1", "2" }, { "push", "3" }, { "map", "push", "4" },
+		{ "show" } });
+	Interface commands(
+		func(pack(&log, &Log::push), "push", "Append a value.",
+			param("value", "value")),
+		func(pack(&log, &Log::show), "show", "Show the log."));
+
+	commands.batch(io);
+	REQUIRE(io.output == "1234\n");
+}
+
+TEST_CASE("Built in commands of an input / output object", "[jobs]") {
+	MemoryIO io({ { "help" }, { "stats" }, { "jobs" } });
+	Interface commands(
+		func(add, "add", "Add a list of numbers.",
+			param("v", "vector of numbers")));
+
+	io.builtins = Builtin::MAP;
+	commands.run(io);
+	REQUIRE(
+		io.output ==
+		"Available commands:\n"
+		"  add\t\tAdd a list of numbers.\n"
+		"  help\t\tHelp on a specific command.\n"
+		"  map\t\tRun a command once for every set of arguments.\n"
+		"Unknown command: stats\n"
+		"Available commands:\n"
+		"  add\t\tAdd a list of numbers.\n"
+		"  help\t\tHelp on a specific command.\n"
+		"  map\t\tRun a command once for every set of arguments.\n"
+		"Job control is not available here.\n");
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "interface.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+int increase(int a) {
+	return a + 1;
+}
+
+float multiply(float a, int b) {
+	return a * b;
+}
+
+int power(int a, int b) {
+	int result{ 1 };
+	for (int i{ 0 }; i < b; i++) {
+		result *= a;
+	}
+	return result;
+}
+
+int twice(int a) {
+	return 2 * a;
+}
+
+size_t kernelCalls{ 0 };
+
+vector<int> increaseAll(vector<int> const &a) {
+	vector<int> result(a.size());
+
+	kernelCalls++;
+	for (size_t i{ 0 }; i < a.size(); i++) {
+		result[i] = a[i] + 1;
+	}
+	return result;
+}
+
+TEST_CASE("Map command", "[map]") {
+	MemoryIO io({
+		{ "map", "inc", "1", "2", "3" }, { "map", "mul", "-a", "2", "1", "3" },
+		{ "map", "pow", "2", "3", "3", "2" }, { "map", "pow", "2", "3", "3" },
+		{ "map", "inc", "1", "x" } });
+	Interface commands(
+		func(increase, "inc", "Increment a value.",
+			param("value", "value to be incremented")),
+		func(multiply, "mul", "Multiply a floating point number.",
+			param("-a", 1.1F, "value to be multiplied"),
+			param("b", "multiplier")),
+		func(power, "pow", "Raise to a power.",
+			param("a", "base"), param("b", "exponent")));
+
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "2\n3\n4\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "2\n6\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "8\n9\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output.substr(0, 28) == "Required parameter missing.\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output.substr(0, 28) == "Wrong type for parameter 1\nA");
+}
+
+TEST_CASE("Map without required parameters", "[map]") {
+	MemoryIO io({
+		{ "map", "double" }, { "map", "double", "-a", "3" },
+		{ "map", "double", "3" } });
+	Interface commands(
+		func(twice, "double", "Double a value.",
+			param("-a", 1, "value to be doubled")));
+
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "2\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "6\n");
+
+	io.output.clear();
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output.substr(0, 20) == "Excess parameter: 1\n");
+}
+
+TEST_CASE("Map batch overload", "[map]") {
+	MemoryIO io({ { "map", "inc", "1", "2", "3" }, { "inc", "4" } });
+	Interface commands(
+		func(batched(increase, increaseAll), "inc", "Increment a value.",
+			param("value", "value to be incremented")));
+	vector<string_view> args{ "5", "6" };
+
+	kernelCalls = 0;
+	REQUIRE(commands.step(io));
+	REQUIRE(commands.step(io));
+	REQUIRE(io.output == "2\n3\n4\n5\n");
+	REQUIRE(kernelCalls == 1);
+
+	io.output.clear();
+	REQUIRE(commands.map(io, "inc", args));
+	REQUIRE(io.output == "6\n7\n");
+	REQUIRE(kernelCalls == 2);
+	REQUIRE(not commands.map(io, "dec", args));
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "interface.hpp"
+#include "metrics.hpp"
+
+using namespace commandIO;
+
+using std::string;
+
+int metricsProbe(int a) {
+	return a;
+}
+
+TEST_CASE("Shared memory metrics", "[metrics]") {
+	Interface commands(
+		func(metricsProbe, "metricsProbe", "Return a value.", param("a", "value")));
+	string name{ metricsName() + "-test" };
+	MetricsPublisher publisher;
+	MetricsReader reader;
+	Metrics metrics;
+
+	REQUIRE(not reader.open(name));
+	REQUIRE(publisher.open(name));
+	REQUIRE(reader.open(name));
+
+	std::thread thread([&]() {
+		MemoryIO io({ { "metricsProbe", "1" }, { "metricsProbe", "x" } });
+		commands.run(io);
+	});
+	thread.join();
+	publisher.publish();
+
+	REQUIRE(reader.read(metrics));
+	REQUIRE(metrics.updates >= 2);
+#ifdef COMMANDIO_NO_STATS
+	REQUIRE(metrics.size == 0);
+#else
+	MetricsCommand const *command{ nullptr };
+	for (size_t i{ 0 }; i < metrics.size; i++) {
+		if (not strcmp(metrics.commands[i].name, "metricsProbe")) {
+			command = &metrics.commands[i];
+		}
+	}
+
+	REQUIRE(command);
+	REQUIRE(command->calls == 2);
+	REQUIRE(command->errors[Error::INVALID_PARAM_TYPE] == 1);
+	REQUIRE(command->max >= command->p50);
+	REQUIRE(metrics.dispatched >= 2);
+#endif
+
+	publisher.close();
+
+	MetricsReader closed;
+	REQUIRE(not closed.open(name));
+}
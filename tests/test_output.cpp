@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include "output.hpp"
+
+using namespace commandIO;
+
+using std::string;
+
+string drain(int fd) {
+	string result;
+	char buffer[4096];
+	ssize_t size;
+
+	while ((size = read(fd, buffer, sizeof(buffer))) > 0) {
+		result.append(buffer, size);
+	}
+	close(fd);
+
+	return result;
+}
+
+TEST_CASE("Output buffer", "[output]") {
+	string large(1000, 'x');
+	int fds[2];
+
+	REQUIRE(pipe(fds) == 0);
+	{
+		OutputBuffer output(fds[1], 16);
+
+		REQUIRE(output.policy == Flush::FULL);
+		output.write("ab", 2);
+		output.write(large.data(), large.size());
+		output.write("cd", 2);
+	}
+	close(fds[1]);
+
+	REQUIRE(drain(fds[0]) == "ab" + large + "cd");
+}
+
+TEST_CASE("Output file region", "[output]") {
+	char path[]{ "/tmp/commandIO_XXXXXX" };
+	int file{ mkstemp(path) };
+	int fds[2];
+
+	REQUIRE(file != -1);
+	REQUIRE(write(file, "0123456789", 10) == 10);
+	REQUIRE(pipe(fds) == 0);
+	{
+		OutputBuffer output(fds[1]);
+
+		output.write("<", 1);
+		output.write(FileRegion{ file, 2, 5 });
+		output.write(fileRegion(path));
+		output.write(fileRegion("/nonexistent"));
+		output.write(">", 1);
+	}
+	close(fds[1]);
+	close(file);
+	unlink(path);
+
+	REQUIRE(drain(fds[0]) == "<234560123456789>");
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "output.hpp"
+#include "print.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+struct StringIO {
+	void write(char const *data, size_t size) {
+		output.append(data, size);
+	}
+
+	string output;
+	Format format;
+};
+
+namespace user {
+	struct Point {
+		int x;
+		int y;
+	};
+
+	template <class I>
+	void print(I &io, Point const &p) {
+		commandIO::print(io, "(", p.x, ", ", p.y, ")");
+	}
+}
+
+TEST_CASE("Print numbers", "[print]") {
+	StringIO io;
+
+	print(io, 12, " ", -3L, " ", 0.1, " ", 1.5F, " ", 1e100, " ", true, "\n");
+	REQUIRE(io.output == "12 -3 0.1 1.5 1e+100 1\n");
+}
+
+TEST_CASE("Print containers", "[print]") {
+	StringIO io;
+
+	print(io, vector<int>{ 1, 2, 3 }, "\n", vector<string>{}, "\n");
+	REQUIRE(io.output == "1 2 3\n\n");
+
+	io.output = "";
+	io.format = { ", ", "[", "]" };
+	print(io, vector<vector<double>>{ { 0.5 }, { 1, 2 } });
+	REQUIRE(io.output == "[[0.5], [1, 2]]");
+}
+
+TEST_CASE("Print user types", "[print]") {
+	StringIO io;
+
+	print(io, vector<user::Point>{ { 1, 2 }, { 3, 4 } });
+	REQUIRE(io.output == "(1, 2) (3, 4)");
+}
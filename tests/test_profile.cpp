@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "interface.hpp"
+#include "profile.hpp"
+
+using namespace commandIO;
+
+using std::string;
+
+int profileProbe(int a, int b) {
+	return a + b;
+}
+
+TEST_CASE("Profile a command", "[profile]") {
+	Interface commands(func(
+		profileProbe, "profileProbe", "Add two values.", param("a", "value"),
+		param("b", "value")));
+
+	SECTION("Report") {
+		MemoryIO io({ { "profile", "-n", "50", "profileProbe", "1", "2" } });
+		commands.run(io);
+
+		REQUIRE(io.output.find("profileProbe: 50 runs\ntime us: min ") == 0);
+		REQUIRE(io.output.find("\nper run us: parse ") != string::npos);
+		REQUIRE(io.output.find(" conversion ") != string::npos);
+		REQUIRE(io.output.find(" function ") != string::npos);
+		REQUIRE((
+			io.output.find("hardware counters unavailable\n") != string::npos or
+			io.output.find(" IPC\n") != string::npos));
+#ifndef COMMANDIO_NO_STATS
+		REQUIRE(Stats::snapshot().commands["profileProbe"].calls == 0);
+#endif
+	}
+
+	SECTION("Failure") {
+		MemoryIO io({ { "profile", "profileProbe", "1", "x" } });
+		commands.run(io);
+
+		REQUIRE(io.output.find("runs") == string::npos);
+		REQUIRE(io.output.find("Wrong type for parameter 2") != string::npos);
+	}
+
+	SECTION("Invalid number of runs") {
+		MemoryIO io({ { "profile", "-n", "0", "profileProbe", "1", "2" } });
+		commands.run(io);
+
+		REQUIRE(io.output == "Invalid number of runs.\n");
+	}
+
+	SECTION("Help on the number of runs") {
+		MemoryIO io({ { "help", "profile" }, { "profile", "-n", "-1", "x" } });
+		commands.run(io);
+
+		REQUIRE(
+			io.output.find(
+				"  -n\t\tnumber of runs (type " + typeOf(size_t{}) +
+				", default: 100)\n") != string::npos);
+		REQUIRE(io.output.find("Invalid number of runs.\n") != string::npos);
+	}
+}
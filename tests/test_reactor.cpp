@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "interface.hpp"
+#include "reactor.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::chrono::milliseconds;
+
+TEST_CASE("Reactor timers", "[reactor]") {
+	Reactor reactor;
+	string order;
+
+	reactor.after(milliseconds(20), [&]() { order += "b"; });
+	reactor.after(milliseconds(10), [&]() { order += "a"; });
+	reactor.post([&]() {
+		order += "p";
+		reactor.post([&]() { order += "q"; });
+	});
+	REQUIRE(reactor.pending() == 3);
+
+	while (reactor.pending()) {
+		reactor.run();
+	}
+	REQUIRE(order == "pqab");
+}
+
+TEST_CASE("Reactor file descriptors", "[reactor]") {
+	Reactor reactor;
+	int fds[2];
+	bool readable{ false };
+
+	REQUIRE(pipe(fds) == 0);
+	reactor.watch(fds[0], EPOLLIN, [&]() { readable = true; });
+	reactor.run(0);
+	REQUIRE(not readable);
+
+	REQUIRE(write(fds[1], "x", 1) == 1);
+	reactor.run();
+	REQUIRE(readable);
+	REQUIRE(not reactor.pending());
+
+	// A second watch on the same file descriptor.
+	readable = false;
+	reactor.watch(fds[0], EPOLLIN, [&]() { readable = true; });
+	reactor.run();
+	REQUIRE(readable);
+
+	close(fds[0]);
+	close(fds[1]);
+}
+
+TEST_CASE("Reactor waiters on one file descriptor", "[reactor]") {
+	Reactor reactor;
+	int fds[2];
+	string order;
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+	reactor.watch(fds[0], EPOLLIN, [&]() { order += "r"; });
+	reactor.watch(fds[0], EPOLLIN, [&]() { order += "R"; });
+	reactor.watch(fds[0], EPOLLOUT, [&]() { order += "w"; });
+	REQUIRE(reactor.pending() == 3);
+
+	reactor.run();
+	REQUIRE(order == "w");
+	REQUIRE(reactor.pending() == 2);
+
+	REQUIRE(write(fds[1], "x", 1) == 1);
+	reactor.run();
+	REQUIRE(order.size() == 3);
+	REQUIRE(order.find('r') != string::npos);
+	REQUIRE(order.find('R') != string::npos);
+	REQUIRE(not reactor.pending());
+
+	close(fds[0]);
+	close(fds[1]);
+}
+
+#ifdef COMMANDIO_COROUTINES
+Task<int> square(int value) {
+	co_return value * value;
+}
+
+Task<int> delayed(int ms, int value) {
+	co_await sleep(milliseconds(ms));
+	co_return co_await square(value);
+}
+
+TEST_CASE("Task commands", "[reactor]") {
+	MemoryIO io({ { "delayed", "20", "2" }, { "delayed", "10", "3" } });
+	Interface commands(
+		func(delayed, "delayed", "Square a value after a delay.",
+			param("ms", "delay"), param("value", "value")));
+
+	commands.run(io);
+	REQUIRE(io.output == "9\n4\n");
+	REQUIRE(not io.tasks);
+}
+
+class Delay {
+public:
+	Task<int> add(int ms, int value) {
+		co_await sleep(milliseconds(ms));
+		total_ += value;
+		co_return total_;
+	}
+
+	Task<int> total(int ms) const {
+		co_await sleep(milliseconds(ms));
+		co_return total_;
+	}
+
+private:
+	int total_{ 0 };
+};
+
+TEST_CASE("Class member task commands", "[reactor]") {
+	Delay delay;
+	MemoryIO io({
+		{ "delayedAdd", "20", "2" }, { "delayedTotal", "10" },
+		{ "delayedAdd", "0", "3" } });
+	Interface commands(
+		func(pack(&delay, &Delay::add), "delayedAdd",
+			"Add a value after a delay.", param("ms", "delay"),
+			param("value", "value")),
+		func(pack(&delay, &Delay::total), "delayedTotal",
+			"Show the total after a delay.", param("ms", "delay")));
+
+	commands.run(io);
+	REQUIRE(io.output == "3\n3\n5\n");
+	REQUIRE(not io.tasks);
+}
+
+Task<int> failing(int ms) {
+	co_await sleep(milliseconds(ms));
+	throw std::runtime_error("no value");
+}
+
+TEST_CASE("Failing task commands", "[reactor]") {
+	MemoryIO io({ { "failing", "10" }, { "failing", "0" } });
+	Interface commands(
+		func(failing, "failing", "Fail after a delay.", param("ms", "delay")));
+
+	commands.run(io);
+	REQUIRE(io.output == "Task failed: no value\nTask failed: no value\n");
+	REQUIRE(not io.tasks);
+#ifndef COMMANDIO_NO_STATS
+	REQUIRE(Stats::snapshot().commands["failing"].errors[errorKinds - 1] == 2);
+#endif
+}
+#endif
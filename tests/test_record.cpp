@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "interface.hpp"
+#include "record.hpp"
+
+using namespace commandIO;
+
+using std::string;
+using std::vector;
+
+string echo(string s) {
+	return s;
+}
+
+TEST_CASE("Record and replay", "[record]") {
+	Interface commands(
+		func(echo, "echo", "Echo a string.", param("s", "string")));
+	char path[]{ "/tmp/test_record_XXXXXX" };
+	int fd{ mkstemp(path) };
+
+	{
+		MemoryIO io({
+			{ "echo", "a b" }, { "echo", "x\"y\\" }, { "echo" }, { "exit" } });
+		Recording recording;
+		Recorder<MemoryIO> recorder(io, recording);
+
+		REQUIRE(recording.open(path, false));
+		commands.run(recorder);
+		REQUIRE(recording.records.size() == 3);
+		REQUIRE(recording.records[0].tokens == vector<string>{ "echo", "a b" });
+		REQUIRE(
+				recording.records[0].hash == hash(hashBasis, "a b\n", 4));
+		REQUIRE(recording.records[2].tokens == vector<string>{ "echo" });
+	}
+
+	Recording recording;
+	REQUIRE(recording.load(path));
+	REQUIRE(recording.records.size() == 4);
+	REQUIRE(recording.records[1].tokens == vector<string>{ "echo", "x\"y\\" });
+	REQUIRE(recording.records[3].tokens == vector<string>{ "exit" });
+
+	Report report{ replay(commands, recording, { 0, 4 }) };
+	REQUIRE(report.commands == 12);
+	REQUIRE(report.mismatches.empty());
+	REQUIRE(report.percentile(0.5) <= report.percentile(0.99));
+	REQUIRE(report.commandLatencies.size() == 1);
+	REQUIRE(report.commandLatencies["echo"].size() == 12);
+	REQUIRE(report.percentile("echo", 0.5) <= report.percentile("echo", 0.999));
+
+	recording.records[1].hash++;
+	report = replay(commands, recording, { 0, 1 });
+	REQUIRE(report.mismatches.size() == 1);
+	REQUIRE(report.mismatches[0].command == 1);
+
+	close(fd);
+	remove(path);
+}
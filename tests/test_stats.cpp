@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "interface.hpp"
+#include "stats.hpp"
+
+using namespace commandIO;
+
+using std::string;
+
+int probe(int a) {
+	return a;
+}
+
+TEST_CASE("Latency histogram", "[stats]") {
+	uint64_t values[]{ 0, 7, 8, 9, 15, 16, 17, 1000, 123456789, UINT64_MAX };
+
+	for (uint64_t value: values) {
+		size_t bucket{ Histogram::bucket(value) };
+
+		REQUIRE(bucket < Histogram::size);
+		REQUIRE(value <= Histogram::upper(bucket));
+		REQUIRE((not bucket or value > Histogram::upper(bucket - 1)));
+	}
+}
+
+TEST_CASE("Command statistics", "[stats]") {
+	Interface commands(
+		func(probe, "statsProbe", "Return a value.", param("a", "value")));
+
+	std::thread thread([&]() {
+		MemoryIO io({
+			{ "statsProbe", "1" }, { "statsProbe", "x" }, { "statsProbe" },
+			{ "map", "statsProbe", "1", "2" }, { "statsUndefined" } });
+		commands.run(io);
+	});
+	thread.join();
+
+	MemoryIO io({ { "stats" } });
+	commands.run(io);
+
+#ifdef COMMANDIO_NO_STATS
+	REQUIRE(io.output == "Statistics are disabled.\n");
+#else
+	REQUIRE(io.output.find("statsProbe\t\t4\t2\t") != string::npos);
+	REQUIRE(
+		io.output.find("  invalid type: 1\n  missing parameter: 1\nio: ") !=
+		string::npos);
+	REQUIRE(io.output.find("\n(unknown)\t\t") != string::npos);
+#endif
+}
+
+TEST_CASE("Write statistics", "[stats]") {
+	IOTotals before{ Stats::snapshot().io };
+	int fds[2];
+
+	REQUIRE(pipe(fds) == 0);
+	{
+		OutputBuffer output(fds[1], 64);
+
+		for (int i{ 0 }; i < 10; i++) {
+			output.write("abc", 3);
+		}
+	}
+	close(fds[0]);
+	close(fds[1]);
+
+	IOTotals after{ Stats::snapshot().io };
+#ifdef COMMANDIO_NO_STATS
+	REQUIRE(after.writes == before.writes);
+#else
+	REQUIRE(after.writes - before.writes == 1);
+	REQUIRE(after.bytesWritten - before.bytesWritten == 30);
+#endif
+}
+
+// Run by the test below in a process of its own.
+TEST_CASE("Shared pool before statistics", "[.][statsExit]") {
+	Interface commands(
+		func(probe, "statsProbe", "Return a value.", param("a", "value")));
+	ThreadPool &pool{ ThreadPool::shared() };
+	std::promise<void> done;
+
+	pool.submit([&]() {
+		MemoryIO io({ { "statsProbe", "1" }, { "statsProbe", "2" } });
+		commands.run(io);
+		done.set_value();
+	});
+	done.get_future().wait();
+}
+
+TEST_CASE("Statistics outlive the shared pool", "[stats]") {
+	char path[4096]{};
+
+	REQUIRE(readlink("/proc/self/exe", path, sizeof(path) - 1) > 0);
+	REQUIRE(
+		std::system(
+			("'" + string(path) + "' '[statsExit]' > /dev/null 2>&1").c_str()) ==
+		0);
+}
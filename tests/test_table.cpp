@@ -0,0 +1,39 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "table.hpp"
+
+using namespace commandIO;
+
+void f() {}
+
+TEST_CASE("Command table", "[table]") {
+	constexpr auto defs{ pack(
+			func(f, "add", ""), func(f, "sub", ""), func(f, "show", ""),
+			func(f, "add", "")) };
+	constexpr Table<4> table{ defs };
+
+	static_assert(table.find("sub", 3) == 1);
+
+	REQUIRE(table.find("add", 3) == 0);
+	REQUIRE(table.find("show", 4) == 2);
+	REQUIRE(table.find("sho", 3) == 4);
+	REQUIRE(table.find("", 0) == 4);
+}
+
+TEST_CASE("Command table size", "[table]") {
+	std::string names[]{ "a", "b", "c", "d", "e", "f", "g", "h", "i" };
+	auto defs{ pack(
+			func(f, names[0].c_str(), ""), func(f, names[1].c_str(), ""),
+			func(f, names[2].c_str(), ""), func(f, names[3].c_str(), ""),
+			func(f, names[4].c_str(), ""), func(f, names[5].c_str(), ""),
+			func(f, names[6].c_str(), ""), func(f, names[7].c_str(), ""),
+			func(f, names[8].c_str(), "")) };
+	Table<9> table{ defs };
+
+	for (size_t i{ 0 }; i < 9; i++) {
+		REQUIRE(table.find(names[i].data(), names[i].size()) == i);
+	}
+	REQUIRE(table.find("j", 1) == 9);
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "types.hpp"
+
+using namespace commandIO;
+
+TEST_CASE("Convert integers", "[types]") {
+	int i;
+	unsigned char c;
+	short int h;
+	unsigned int u;
+	long long int l;
+
+	REQUIRE(convert(&i, "12") == Error::SUCCESS);
+	REQUIRE(i == 12);
+	REQUIRE(convert(&i, "+12") == Error::SUCCESS);
+	REQUIRE(i == 12);
+	REQUIRE(convert(&i, "-0x1f") == Error::SUCCESS);
+	REQUIRE(i == -31);
+	REQUIRE(convert(&i, "0b101") == Error::SUCCESS);
+	REQUIRE(i == 5);
+	REQUIRE(convert(&h, "-32768") == Error::SUCCESS);
+	REQUIRE(h == -32768);
+	REQUIRE(convert(&l, "-9223372036854775808") == Error::SUCCESS);
+	REQUIRE(l == std::numeric_limits<long long int>::min());
+	REQUIRE(convert(&u, "-0") == Error::SUCCESS);
+	REQUIRE(u == 0);
+	REQUIRE(convert(&c, "x") == Error::SUCCESS);
+	REQUIRE(c == 'x');
+
+	REQUIRE(convert(&i, "12abc") == Error::TRAILING_CHARACTERS);
+	REQUIRE(convert(&i, "0x") == Error::TRAILING_CHARACTERS);
+	REQUIRE(convert(&c, "xy") == Error::TRAILING_CHARACTERS);
+	REQUIRE(convert(&i, "abc") == Error::INVALID_PARAM_TYPE);
+	REQUIRE(convert(&i, "") == Error::INVALID_PARAM_TYPE);
+	REQUIRE(convert(&i, "--1") == Error::INVALID_PARAM_TYPE);
+	REQUIRE(convert(&h, "32768") == Error::OUT_OF_RANGE);
+	REQUIRE(convert(&u, "-1") == Error::OUT_OF_RANGE);
+	REQUIRE(convert(&l, "99999999999999999999") == Error::OUT_OF_RANGE);
+}
+
+TEST_CASE("Convert other types", "[types]") {
+	bool b;
+	float f;
+	double d;
+	string s;
+	vector<int> v;
+
+	REQUIRE(convert(&b, "true") == Error::SUCCESS);
+	REQUIRE(b);
+	REQUIRE(convert(&b, "0") == Error::SUCCESS);
+	REQUIRE(not b);
+	REQUIRE(convert(&b, "yes") == Error::INVALID_PARAM_TYPE);
+
+	REQUIRE(convert(&f, "+1.5") == Error::SUCCESS);
+	REQUIRE(f == 1.5F);
+	REQUIRE(convert(&d, "-2e3") == Error::SUCCESS);
+	REQUIRE(d == -2e3);
+	REQUIRE(convert(&d, "1.5x") == Error::TRAILING_CHARACTERS);
+	REQUIRE(convert(&d, "1e999") == Error::OUT_OF_RANGE);
+	REQUIRE(convert(&d, "x") == Error::INVALID_PARAM_TYPE);
+
+	REQUIRE(convert(&s, "a b") == Error::SUCCESS);
+	REQUIRE(s == "a b");
+
+	REQUIRE(convert(&v, "1") == Error::SUCCESS);
+	REQUIRE(convert(&v, "2") == Error::SUCCESS);
+	REQUIRE(v == vector<int>{ 1, 2 });
+}